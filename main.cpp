@@ -3,6 +3,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <deque>
 #include "json.hpp"
 #include <ctime>
 #include <iomanip>
@@ -11,6 +12,30 @@
 #include <stdexcept>
 #include <exception>
 #include <conio.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cctype>
+#include <unordered_map>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <future>
+#include <atomic>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 class SystemBankowy;
 using namespace std;
@@ -28,1192 +53,2506 @@ public:
 	Error(const string& message) : invalid_argument(message) {}
 };
 
-
 /**
- * @class Karta
- * @brief Reprezentuje karte.
- *
+ * @class Pieniadze
+ * @brief Kwota pieniezna przechowywana jako calkowita liczba groszy.
  *
- *  Klasa przechowuje podstawowe dane i funkcje zwiazane z kartami
+ * Dodawanie, odejmowanie i porownania sa dokladne. Zaokraglenia wystepuja tylko
+ * w dwoch miejscach i zawsze do najblizszego grosza, polowki od zera:
+ * przy zamianie z liczby zmiennoprzecinkowej (pliki JSON) oraz przy naliczaniu procentu.
+ * Kwoty wpisywane przez uzytkownika sa parsowane dokladnie z tekstu.
  */
-class Karta {
+class Pieniadze {
 private:
-	string numerKarty; ///< Numer karty
-	string dataWaznosci; ///< Data waznosci karty
-	string kodCVC; ///< Kod CVC karty
-	string pin; ///< Pin karty
+	int64_t grosze = 0; ///< Kwota w groszach
+
+	explicit Pieniadze(int64_t grosze) : grosze(grosze) {}
 public:
+	Pieniadze() = default;
 	/**
-	 * @brief Konstruktor klasy Karta.
-	 *
-	 * Inicjalizuje obiekt Karta z podanymi parametrami.
-	 *
-	 * @param numer Numer karty
-	 * @param data Data waznosci karty
-	 * @param kod Kod CVC karty
+	 * @brief Tworzy kwote z liczby groszy.
 	 */
-	Karta(string numer, string data, string kod) {
-		this->numerKarty = numer;
-		this->dataWaznosci = data;
-		this->kodCVC = kod;
-
-	}
+	static Pieniadze zGroszy(int64_t grosze) { return Pieniadze(grosze); }
 	/**
-	 * @brief Zwraca numer karty.
-	 *
-	 * @return Numer karty
+	 * @brief Tworzy kwote z liczby zlotych, zaokraglajac do najblizszego grosza.
 	 */
-	string getNumerKarty() const { return numerKarty; }
+	static Pieniadze zZlotych(double zlote) { return Pieniadze(static_cast<int64_t>(llround(zlote * 100.0))); }
 	/**
-	 * @brief Zwraca date waznosci karty.
+	 * @brief Parsuje kwote w formacie "123", "123.4" lub "123,45" bez utraty dokladnosci.
 	 *
-	 * @return Data waznosci karty
+	 * @param tekst Tekst do sparsowania
+	 * @param wynik Sparsowana kwota
+	 * @return true jesli tekst jest poprawna kwota z najwyzej dwoma miejscami po przecinku
 	 */
-	string getDataWaznosci() const
+	static bool parsuj(const string& tekst, Pieniadze& wynik)
 	{
-		if (dataWaznosci.length() == 4) {
-			return dataWaznosci.substr(0, 2) + "/20" + dataWaznosci.substr(2, 2);
+		size_t i = 0;
+		bool ujemna = !tekst.empty() && tekst[0] == '-';
+		if (ujemna) i++;
+		int64_t zlote = 0;
+		size_t cyfryZlotych = 0;
+		for (; i < tekst.length() && isdigit(static_cast<unsigned char>(tekst[i])); i++, cyfryZlotych++)
+		{
+			if (zlote > (INT64_MAX / 100 - 9) / 10) return false; // Przepelnienie
+			zlote = zlote * 10 + (tekst[i] - '0');
 		}
-		else
+		int64_t groszeCzesci = 0;
+		size_t cyfryGroszy = 0;
+		if (i < tekst.length() && (tekst[i] == '.' || tekst[i] == ','))
 		{
-			return dataWaznosci;
+			for (i++; i < tekst.length() && isdigit(static_cast<unsigned char>(tekst[i])); i++, cyfryGroszy++)
+			{
+				if (cyfryGroszy == 2) return false; // Kwota nie moze miec ulamkow grosza
+				groszeCzesci = groszeCzesci * 10 + (tekst[i] - '0');
+			}
+			if (cyfryGroszy == 1) groszeCzesci *= 10;
 		}
+		if (i != tekst.length() || cyfryZlotych + cyfryGroszy == 0) return false;
+		int64_t suma = zlote * 100 + groszeCzesci;
+		wynik = Pieniadze(ujemna ? -suma : suma);
+		return true;
 	}
+
 	/**
-	 * @brief Zwraca kod CVC karty.
-	 *
-	 * @return Kod CVC karty
+	 * @brief Zwraca kwote w groszach.
 	 */
-	string getKodCVC() const { return kodCVC; }
+	int64_t getGrosze() const { return grosze; }
 	/**
-	 * @brief Ustala numer karty.
-	 *
-	 * @param numer Numer karty
+	 * @brief Zwraca kwote w zlotych jako liczbe zmiennoprzecinkowa (do zapisu w JSON).
 	 */
-	void setNumerKarty(string numer) { numerKarty = numer; }
+	double naZlote() const { return grosze / 100.0; }
 	/**
-	 * @brief Ustala date waznosci karty.
-	 *
-	 * @param data Data waznosci karty
+	 * @brief Zwraca kwote w formacie "1234.56".
 	 */
-	void setDataWaznosci(string data)
+	string toString() const
 	{
-		if (data.length() ==4) // Format "MMRR"
-		{
-			dataWaznosci = data;
-		}
-		else if (data.length()==7 && data[2] == '/') // Format "MM/YYYY"
-		{
-			dataWaznosci = data.substr(0, 2) + data.substr(5, 2);
-		}
-		else if (data.length() == 6)
-		{
-			dataWaznosci = data.substr(0, 2) + data.substr(4, 2);
-		}
-		else
-		{
-			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
-		}
+		uint64_t wartosc = grosze < 0 ? 0 - static_cast<uint64_t>(grosze) : static_cast<uint64_t>(grosze);
+		string groszeTekst = to_string(wartosc % 100);
+		if (groszeTekst.length() == 1) groszeTekst = "0" + groszeTekst;
+		return (grosze < 0 ? "-" : "") + to_string(wartosc / 100) + "." + groszeTekst;
 	}
 	/**
-	 * @brief Ustala kod CVC karty.
+	 * @brief Oblicza podany procent kwoty, podzielony na okresy (np. 12 dla odsetek miesiecznych).
 	 *
-	 * @param kod Kod CVC karty
+	 * @param stopa Stopa procentowa, np. 3.5 dla 3,5%
+	 * @param okresy Liczba okresow, na ktore dzielona jest stopa
+	 * @return Wynik zaokraglony do grosza, polowki od zera
 	 */
-	void setKodCVC(string kod) { kodCVC = kod; }
-
-	/**
-	* @brief Ustala pin karty.
-	*
-	* @param nowyPin Pin karty
-	*/
-	void setPin(const string& nowyPin) {
-		if (nowyPin.length() == 4) {  // Weryfikacja długości PINu
-			pin = nowyPin;
-		}
-		else {
-			throw Error(", PIN musi miec 4 cyfry");
-		}
+	Pieniadze procent(double stopa, int okresy = 1) const
+	{
+		return Pieniadze(procentGroszy(grosze, stopa, okresy));
 	}
 	/**
-	 * @brief Zwraca typ karty.
+	 * @brief Oblicza procent kwoty podanej w groszach - jedyne miejsce zaokraglania procentow.
 	 *
-	 * @return Typ karty (np. Debetowa, Kredytowa)
-	 */
-	virtual string getTypKarty() const = 0;
-
-	/**
-	* @brief Zwraca pin karty.
-	*
-	* @return Pin karty
-	*/
-	string getPin() const { return pin; }
-	/**
-	 * @brief Sprawdza, czy karta jest wazna.
-	 * @return true jeśli karta jest wazna, false w przeciwnym razie
+	 * Bez rozgalezien i bez long double, wiec petle po kolumnach MagazynKont (kapitalizacja)
+	 * moga byc wektoryzowane, a wynik jest ten sam co dla pojedynczej kwoty.
+	 *
+	 * @param grosze Kwota w groszach
+	 * @param stopa Stopa procentowa, np. 3.5 dla 3,5%
+	 * @param okresy Liczba okresow, na ktore dzielona jest stopa
+	 * @return Wynik w groszach, zaokraglony do grosza, polowki od zera
 	 */
-	virtual bool czyWazna() const
+	static int64_t procentGroszy(int64_t grosze, double stopa, int okresy = 1)
 	{
-		string dataWaznosci = getDataWaznosci();
-
-		if (dataWaznosci.length() == 7 && dataWaznosci[2] == '/')
-		{
-			dataWaznosci = dataWaznosci.substr(0, 2) + dataWaznosci.substr(5, 2); // Konwersja z formatu MM/YYYY na MMRR
-		}
+		double wynik = grosze * stopa / (100.0 * okresy);
+		return static_cast<int64_t>(wynik + (wynik < 0 ? -0.5 : 0.5));
+	}
 
-		if (dataWaznosci.length() != 4) {
-			return false; // Niepoprawny format daty
-		}
-		try{
-			// Pobiera aktualny czas i konwertuje na lokalny dzien, miesiac
-		time_t now = time(nullptr);
-		tm today;
-		localtime_s(&today, &now);
+	bool czyDodatnia() const { return grosze > 0; }
+	bool czyUjemna() const { return grosze < 0; }
+
+	Pieniadze operator+(Pieniadze inna) const { return Pieniadze(grosze + inna.grosze); }
+	Pieniadze operator-(Pieniadze inna) const { return Pieniadze(grosze - inna.grosze); }
+	Pieniadze& operator+=(Pieniadze inna) { grosze += inna.grosze; return *this; }
+	Pieniadze& operator-=(Pieniadze inna) { grosze -= inna.grosze; return *this; }
+	bool operator==(Pieniadze inna) const { return grosze == inna.grosze; }
+	bool operator!=(Pieniadze inna) const { return grosze != inna.grosze; }
+	bool operator<(Pieniadze inna) const { return grosze < inna.grosze; }
+	bool operator>(Pieniadze inna) const { return grosze > inna.grosze; }
+	bool operator<=(Pieniadze inna) const { return grosze <= inna.grosze; }
+	bool operator>=(Pieniadze inna) const { return grosze >= inna.grosze; }
+};
 
-		int miesiac = stoi(dataWaznosci.substr(0, 2));
-		int rok = 2000 + stoi(dataWaznosci.substr(2, 2));
+/**
+ * @brief Wypisuje kwote z dokladnie dwoma miejscami po przecinku.
+ */
+inline ostream& operator<<(ostream& strumien, Pieniadze kwota)
+{
+	return strumien << kwota.toString();
+}
 
-		return (rok > today.tm_year + 1900 || (rok == today.tm_year + 1900 && miesiac >= today.tm_mon + 1));
-		}
-		catch (...) {
-			return false; // Niepoprawny format daty
-		}
-	}
-	/**
-	 * @brief Wyswietla informacje o karcie.
-	 *
-	 * Funkcja wyswietla szczegóły karty, takie jak numer karty, data waznosci, kod CVC oraz status karty.
-	 */
-	virtual void wyswietlInformacje() const
+/**
+ * @brief Wczytuje kwote ze strumienia; niepoprawny tekst ustawia failbit.
+ */
+inline istream& operator>>(istream& strumien, Pieniadze& kwota)
+{
+	string tekst;
+	if (strumien >> tekst && !Pieniadze::parsuj(tekst, kwota))
 	{
-		cout << "===== DANE KARTY =====" << endl;
-		cout << "Typ karty: " << getTypKarty() << endl;
-		cout << "Numer karty: " << getNumerKarty() << endl;
-		cout << "Data waznosci: " << getDataWaznosci() << endl;
-		cout << "Kod CVC: " << getKodCVC() << endl;
-		cout << "Status: " << (czyWazna() ? "Wazna" : "Niewazna") << endl;
-		cout << "======================" << endl;
+		strumien.setstate(ios::failbit);
 	}
-};
+	return strumien;
+}
 
 
 /**
- * @class Lokata
- * @brief Reprezentuje lokate.
+ * @class SlownikNumerow
+ * @brief Slownik numerow kont zamieniajacy kazdy numer na gesty identyfikator uint32_t.
  *
- * Klasa przechowuje kwote, oprocentowanie oraz date oddania.
+ * Konta, karty, lokaty i transakcje przechowuja tylko identyfikator, wiec laczenie danych
+ * i filtrowanie historii porownuje liczby zamiast napisow. Identyfikator 0 zawsze oznacza
+ * pusty numer (np. konto nadawcy przy wplacie).
+ *
+ * Numery leza w blokach stalej wielkosci, ktore nigdy nie sa przenoszone, dlatego numer(id)
+ * nie wymaga blokady: watek, ktory otrzymal identyfikator z dodaj() lub po wczytaniu danych,
+ * moze go bezpiecznie odczytac, nawet gdy inne watki dodaja kolejne numery.
  */
-class Lokata {
-	float kwota; ///< Kwota lokaty
-	float oprocentowanie; ///< Oprocentowanie lokaty
-	string dataOddania; ///< Data oddania lokaty
-	string powiazaneKonto; ///< Powiązane konto bankowe
+class SlownikNumerow
+{
+private:
+	static const uint32_t BITY_BLOKU = 16; ///< Blok miesci 65536 numerow
+	static const uint32_t ROZMIAR_BLOKU = 1u << BITY_BLOKU;
+	static const uint32_t MAKS_BLOKOW = 65536; ///< Razem 2^32 identyfikatorow
+
+	unique_ptr<unique_ptr<string[]>[]> bloki; ///< Tablica blokow o stalej dlugosci MAKS_BLOKOW
+	uint32_t liczba; ///< Liczba numerow (wraz z pustym)
+	unordered_map<string, uint32_t> identyfikatory; ///< Identyfikator dla kazdego numeru
+	mutable mutex blokada; ///< Chroni identyfikatory, liczbe i tworzenie blokow
 
-public:
 	/**
-	 * @brief Konstruktor klasy Lokata.
-	 *
-	 * Inicjalizuje obiekt Lokata z podanymi parametrami.
-	 *
-	 * @param kwota Kwota lokaty
-	 * @param oprocentowanie Oprocentowanie lokaty
-	 * @param dataOddania Data oddania lokaty
-	 * @param wlasciciel Wlasciciel lokaty
+	 * @brief Dopisuje numer na koniec slownika; wymaga trzymania blokady.
 	 */
-	Lokata(float kwota, float oprocentowanie, const string& dataOddania, string wlasciciel) {
-		this->kwota = kwota;
-		this->oprocentowanie = oprocentowanie;
-		this->dataOddania = dataOddania;
-		this->powiazaneKonto = wlasciciel;
+	uint32_t dopisz(string numer)
+	{
+		if (liczba == UINT32_MAX) throw Error("Przekroczono liczbe numerow kont.");
+		uint32_t id = liczba;
+		unique_ptr<string[]>& blok = bloki[id >> BITY_BLOKU];
+		if (!blok) blok.reset(new string[ROZMIAR_BLOKU]);
+		blok[id & (ROZMIAR_BLOKU - 1)] = move(numer);
+		identyfikatory.emplace(blok[id & (ROZMIAR_BLOKU - 1)], id);
+		liczba++;
+		return id;
 	}
+
+public:
+	SlownikNumerow() : bloki(new unique_ptr<string[]>[MAKS_BLOKOW]), liczba(0) { wyczysc(); }
+	SlownikNumerow(const SlownikNumerow&) = delete;
+	SlownikNumerow& operator=(const SlownikNumerow&) = delete;
+
 	/**
-	 * @brief Konstruktor domyslny klasy Lokata.
-	 *
-	 * Inicjalizuje obiekt Lokata z domyslnymi wartosciami.
-	 */
-	Lokata() = default;
-	/**
-	 * @brief Ustala kwote lokaty.
-	 *
-	 * @param kwota Kwota lokaty
-	 */
-	void setKwota(float kwota) { this->kwota = kwota; }
-	/**
-	 * @brief Ustala oprocentowanie lokaty.
-	 *
-	 * @param oprocentowanie Oprocentowanie lokaty
-	 */
-	void setOprocentowanie(float oprocentowanie) { this->oprocentowanie = oprocentowanie; }
-	/**
-	 * @brief Ustala date oddania lokaty.
-	 *
-	 * @param dataOddania Data oddania lokaty
+	 * @brief Zwraca slownik wspolny dla calego programu.
 	 */
-	void setDataOddania(const string& dataOddania) { this->dataOddania = dataOddania; }
+	static SlownikNumerow& globalny()
+	{
+		static SlownikNumerow slownik;
+		return slownik;
+	}
 
 	/**
-	* @brief Ustala konto powiazane z dana lokata.
-	*
-	* @param wlasciciel Powiazane konto
-	*/
-	void setPowiazaneKonto(const string& wlasciciel) { this->powiazaneKonto = wlasciciel; }
-	/**
-	 * @brief Zwraca kwote lokaty.
+	 * @brief Zwraca identyfikator numeru, dodajac go do slownika, jesli jeszcze go nie ma.
 	 *
-	 * @return Kwota lokaty
+	 * @param numer Numer konta
+	 * @return Identyfikator numeru
 	 */
-	float getKwota() const { return kwota; }
+	uint32_t dodaj(const string& numer)
+	{
+		if (numer.empty()) return 0;
+		lock_guard<mutex> lock(blokada);
+		auto it = identyfikatory.find(numer);
+		if (it != identyfikatory.end()) return it->second;
+		return dopisz(numer);
+	}
 
 	/**
-	 * @brief Zwraca oprocentowanie lokaty.
+	 * @brief Wyszukuje identyfikator numeru bez dodawania go do slownika.
 	 *
-	 * @return Oprocentowanie lokaty
+	 * @param numer Numer konta
+	 * @param id Znaleziony identyfikator
+	 * @return true jesli numer jest w slowniku
 	 */
-	float getOprocentowanie() const { return oprocentowanie; }
+	bool znajdz(const string& numer, uint32_t& id) const
+	{
+		lock_guard<mutex> lock(blokada);
+		auto it = identyfikatory.find(numer);
+		if (it == identyfikatory.end()) return false;
+		id = it->second;
+		return true;
+	}
 
 	/**
-	 * @brief Zwraca date oddania lokaty.
-	 *
-	 * @return Data oddania lokaty
+	 * @brief Zwraca numer o podanym identyfikatorze.
 	 */
-	string getDataOddania() const { return dataOddania.substr(0, 2) + "/20"
-		+ dataOddania.substr(2, 2); }
-
+	const string& numer(uint32_t id) const { return bloki[id >> BITY_BLOKU][id & (ROZMIAR_BLOKU - 1)]; }
 	/**
-	 * @brief Zwraca konto powiazane z dana lokata.
-	 *
-	 * @return Powiazane konto
+	 * @brief Zwraca liczbe numerow w slowniku (wraz z pustym numerem).
 	 */
-	string getPowiazaneKonto() const { return powiazaneKonto; }
+	size_t size() const
+	{
+		lock_guard<mutex> lock(blokada);
+		return liczba;
+	}
 
 	/**
-	 * @brief Sprawdza czy lokata jest aktywna.
+	 * @brief Zastepuje zawartosc slownika numerami wczytanymi z migawki.
 	 *
-	 * @return true jeśli lokata jest aktywna, false w przeciwnym razie
+	 * @param wczytane Numery w kolejnosci identyfikatorow; pierwszy musi byc pusty, a wszystkie rozne
 	 */
-	bool czyAktywna() const
+	void wczytaj(vector<string>&& wczytane)
 	{
-		if (dataOddania.length() != 4)
-		{
-			return false; // Niepoprawny format daty
-		}
-		try
-		{
-			// Pobiera aktualny czas i konwertuje na lokalny dzien, miesiac
-			time_t now = time(nullptr);
-			tm today;
-			localtime_s(&today, &now);
-
-			int miesiac = stoi(dataOddania.substr(0, 2));
-			int rok = 2000 + stoi(dataOddania.substr(2, 2));
-
-			return (rok > today.tm_year + 1900 || (rok == today.tm_year + 1900 && miesiac >= today.tm_mon + 1));
-		}
-		catch (...)
+		if (wczytane.empty() || !wczytane[0].empty()) throw Error("Niepoprawny slownik numerow kont.");
+		wyczysc();
+		lock_guard<mutex> lock(blokada);
+		identyfikatory.reserve(wczytane.size());
+		for (size_t i = 1; i < wczytane.size(); i++)
 		{
-			return false; // Niepoprawny format daty
+			if (identyfikatory.count(wczytane[i]) > 0) throw Error("Powtorzony numer w slowniku numerow kont.");
+			dopisz(move(wczytane[i]));
 		}
 	}
+
 	/**
-	 * @brief Oblicza zysk z lokaty.
-	 *
-	 * @return Zysk z lokaty
+	 * @brief Usuwa wszystkie numery poza pustym.
 	 */
-	double obliczZysk() const
+	void wyczysc()
 	{
-		if (oprocentowanie < 0) return 0.0; // Oprocentowanie nie moze byc ujemne
-		return kwota * (oprocentowanie / 100);
+		lock_guard<mutex> lock(blokada);
+		for (uint32_t i = 0; i < MAKS_BLOKOW && bloki[i]; i++) bloki[i].reset();
+		identyfikatory.clear();
+		liczba = 0;
+		dopisz(string());
 	}
+};
 
-	/**
- * @brief Wyswietla informacje o lokacie.
+/**
+ * @brief Dzieli zakres [0, liczba) na czesci i wykonuje funkcja(od, do) na osobnych watkach.
  *
- * Funkcja wyswietla szczegóły lokaty, takie jak kwota, oprocentowanie, data oddania,
- * zysk roczny oraz status lokaty.
+ * Male zakresy sa wykonywane na biezacym watku. Wyjatek z dowolnej czesci jest
+ * przekazywany dalej dopiero po zakonczeniu wszystkich czesci.
+ *
+ * @param liczba Liczba elementow do przetworzenia
+ * @param funkcja Funkcja przetwarzajaca elementy o indeksach od [od, do)
+ * @param minimalnaCzesc Najmniejsza liczba elementow na watek; mniejsze czesci nie zwracaja kosztu uruchomienia watku
  */
-	void wyswietlInformacje() const
+template <typename Funkcja>
+void wykonajRownolegle(size_t liczba, Funkcja funkcja, size_t minimalnaCzesc = 4096)
+{
+	size_t watki = max<size_t>(1, thread::hardware_concurrency());
+	size_t czesci = min(watki, (liczba + minimalnaCzesc - 1) / minimalnaCzesc);
+	if (czesci <= 1)
 	{
-		cout << "===== DANE LOKATY =====" << endl;
-		cout << "Kwota: " << fixed<<setprecision(2)<<getKwota() <<"PLN"<< endl;
-		cout << "Oprocentowanie: " << getOprocentowanie() << "%" << endl;
-		cout << "Data oddania: " << getDataOddania() << endl;
-		cout << "Zysk roczny: " << obliczZysk() << " PLN" << endl;
-		cout << "Status: " << (czyAktywna() ? "Aktywna" : "Nieaktywna") << endl;
-		cout << "Konto powiazane: " << getPowiazaneKonto() << endl;
-		cout << "======================" << endl;
+		funkcja(size_t(0), liczba);
+		return;
 	}
-};
+
+	size_t rozmiarCzesci = (liczba + czesci - 1) / czesci;
+	vector<future<void>> zadania;
+	for (size_t od = 0; od < liczba; od += rozmiarCzesci)
+	{
+		zadania.push_back(async(launch::async, funkcja, od, min(liczba, od + rozmiarCzesci)));
+	}
+	for (auto& zadanie : zadania) zadanie.wait();
+	for (auto& zadanie : zadania) zadanie.get();
+}
 
 /**
- * @class KontoGlowne
- * @brief Reprezentuje konto.
+ * @class MagazynKont
+ * @brief Kolumnowy magazyn danych liczbowych wszystkich kont.
+ *
+ * Numery, salda, oprocentowanie, miesiac kapitalizacji i liczniki wyplat leza w osobnych
+ * ciaglych tablicach, a obiekty KontoGlowne i KontoOszczednosciowe pamietaja tylko swoj wiersz.
+ * Operacje na calym banku (suma sald, kapitalizacja) przechodza kolejno po jednej kolumnie
+ * zamiast odwiedzac rozrzucone po stercie obiekty.
  *
+ * Wiersze leza w blokach stalej wielkosci, ktore nigdy nie sa przenoszone. Nowe wiersze sa
+ * przydzielane bez blokady, wiec konta moga byc tworzone jednoczesnie przez kilka watkow
+ * (np. przy wczytywaniu migawki). Wiersze usunietych kont trafiaja na liste wolnych.
  *
- *  Klasa przechowuje podtsawowe dane dane i funkcje zwiazane z kontami
+ * Wiersz oznaczony jako zmieniony trafia dodatkowo na liste zmian, wiec zapis zmienionych
+ * kont kosztuje tyle, ile kont sie zmienilo, a nie tyle, ile kont ma bank.
  */
-class KontoGlowne {
+class MagazynKont
+{
+public:
+	static const uint32_t BITY_BLOKU = 16; ///< Blok miesci 65536 kont
+	static const uint32_t ROZMIAR_BLOKU = 1u << BITY_BLOKU;
+	static const uint32_t MAKS_BLOKOW = 65536; ///< Razem 2^32 wierszy
+
+	/// Rodzaj konta zapisanego w wierszu
+	enum Rodzaj : uint8_t { WOLNY = 0, GLOWNE, OSZCZEDNOSCIOWE };
+
+	/**
+	 * @struct Blok
+	 * @brief Kolumny jednego bloku wierszy.
+	 */
+	struct Blok
+	{
+		uint32_t idKonta[ROZMIAR_BLOKU]; ///< Identyfikator numeru w SlownikNumerow
+		atomic<int64_t> saldo[ROZMIAR_BLOKU]; ///< W groszach; wplaty przez fetch_add, wyplaty petla CAS, bez blokad
+		float oprocentowanie[ROZMIAR_BLOKU]; ///< Tylko konta oszczednosciowe
+		uint32_t miesiacKapitalizacji[ROZMIAR_BLOKU]; ///< RRRRMM, 0 - brak poprawnej daty
+		int32_t limitWyplat[ROZMIAR_BLOKU];
+		atomic<uint64_t> wyplaty[ROZMIAR_BLOKU]; ///< (RRRRMM << 32) | liczba wyplat w tym miesiacu; jedno slowo, zeby sprawdzenie limitu i zliczenie byly jednym CAS
+		uint8_t rodzaj[ROZMIAR_BLOKU]; ///< Rodzaj
+		atomic<uint8_t> zmienione[ROZMIAR_BLOKU]; ///< 1 jesli konto zmienilo sie od ostatniego zapisu
+	};
+
 private:
-	string numerKonta; ///< Numer konta
-	string typKonta; ///< Typ konta (np. Osobiste, Oszczędnościowe)
-	float saldoKonta; ///< Saldo konta
-	string wlasciciel; ///< Właściciel konta
+	unique_ptr<atomic<Blok*>[]> bloki; ///< Tablica blokow o stalej dlugosci MAKS_BLOKOW
+	atomic<uint32_t> liczba; ///< Liczba przydzielonych wierszy (razem z wolnymi)
+	atomic<size_t> liczbaWolnych; ///< Rozmiar listy wolnych; pozwala ominac blokade
+	vector<uint32_t> wolne; ///< Wiersze usunietych kont
+	mutex blokada; ///< Chroni wolne
+	vector<uint32_t> zmienioneWiersze; ///< Wiersze oznaczone od ostatniego oproznienia listy (moga sie powtarzac)
+	mutex blokadaZmian; ///< Chroni zmienioneWiersze
 
-public:
 	/**
-	 * @brief Konstruktor klasy Konto.
-	 *
-	 * Inicjalizuje obiekt Konto z podanymi parametrami.
-	 *
-	 * @param numer Numer konta
-	 * @param typ Typ konta (np. Osobiste, Oszczędnościowe)
-	 * @param saldo Saldo konta
+	 * @brief Tworzy blok o podanym numerze, jesli jeszcze nie istnieje.
 	 */
-	KontoGlowne(string numer, string typ, float saldo) {
-			this->numerKonta = numer;
-			this->typKonta = typ;
-			this->saldoKonta = saldo;
+	void zapewnijBlok(uint32_t numer)
+	{
+		if (bloki[numer].load(memory_order_acquire) != nullptr) return;
+		Blok* nowy = new Blok();
+		Blok* oczekiwany = nullptr;
+		if (!bloki[numer].compare_exchange_strong(oczekiwany, nowy, memory_order_acq_rel)) delete nowy;
+	}
+
+public:
+	MagazynKont() : bloki(new atomic<Blok*>[MAKS_BLOKOW]()), liczba(0), liczbaWolnych(0) {}
+	~MagazynKont()
+	{
+		for (uint32_t i = 0; i < MAKS_BLOKOW; i++) delete bloki[i].load();
 	}
+	MagazynKont(const MagazynKont&) = delete;
+	MagazynKont& operator=(const MagazynKont&) = delete;
+
 	/**
-	 * @brief Konstruktor domyslny klasy Konto.
-	 *
-	 * Inicjalizuje obiekt Konto z domyslnymi wartosciami.
+	 * @brief Zwraca magazyn wspolny dla calego programu.
 	 */
-	KontoGlowne() = default;
+	static MagazynKont& globalny()
+	{
+		static MagazynKont magazyn;
+		return magazyn;
+	}
+
 	/**
-	 * @brief Zwraca numer konta.
+	 * @brief Przydziela wyzerowany wiersz dla nowego konta.
 	 *
-	 * @return Numer konta
+	 * @param rodzaj Rodzaj konta
+	 * @return Numer wiersza
 	 */
-	string getNumerKonta() const { return numerKonta; }
+	uint32_t przydziel(Rodzaj rodzaj)
+	{
+		uint32_t wiersz = 0;
+		bool zWolnych = false;
+		if (liczbaWolnych.load(memory_order_relaxed) > 0)
+		{
+			lock_guard<mutex> lock(blokada);
+			if (!wolne.empty())
+			{
+				wiersz = wolne.back();
+				wolne.pop_back();
+				liczbaWolnych.store(wolne.size(), memory_order_relaxed);
+				zWolnych = true;
+			}
+		}
+		if (!zWolnych)
+		{
+			wiersz = liczba.fetch_add(1);
+			zapewnijBlok(wiersz >> BITY_BLOKU);
+		}
+		blok(wiersz).rodzaj[pozycja(wiersz)] = rodzaj;
+		oznaczZmieniony(wiersz);
+		return wiersz;
+	}
 	/**
-	 * @brief Zwraca typ konta.
+	 * @brief Zeruje wiersz usunietego konta i oddaje go do ponownego uzycia.
 	 *
-	 * @return Typ konta (np. Osobiste, Oszczędnościowe)
+	 * @param wiersz Numer wiersza
 	 */
-	string getTypKonta() const { return typKonta; }
+	void zwolnij(uint32_t wiersz)
+	{
+		Blok& b = blok(wiersz);
+		uint32_t i = pozycja(wiersz);
+		b.idKonta[i] = 0;
+		b.saldo[i].store(0, memory_order_relaxed);
+		b.oprocentowanie[i] = 0;
+		b.miesiacKapitalizacji[i] = 0;
+		b.limitWyplat[i] = 0;
+		b.wyplaty[i].store(0, memory_order_relaxed);
+		b.rodzaj[i] = WOLNY;
+		b.zmienione[i].store(0, memory_order_relaxed);
+		lock_guard<mutex> lock(blokada);
+		wolne.push_back(wiersz);
+		liczbaWolnych.store(wolne.size(), memory_order_relaxed);
+	}
 
 	/**
-	 * @brief Zwraca saldo konta.
-	 *
-	 * @return Saldo konta
+	 * @brief Zwraca blok zawierajacy wiersz.
 	 */
-	float getSaldoKonta() const { return saldoKonta; }
+	Blok& blok(uint32_t wiersz) const { return *bloki[wiersz >> BITY_BLOKU].load(memory_order_acquire); }
 	/**
-	 * @brief Zwraca wlasciciela konta.
-	 *
-	 * @return Wlasciciel konta
+	 * @brief Zwraca pozycje wiersza w jego bloku.
 	 */
-	string getWlasciciel() const { return wlasciciel; }
+	static uint32_t pozycja(uint32_t wiersz) { return wiersz & (ROZMIAR_BLOKU - 1); }
+	/**
+	 * @brief Zwraca liczbe przydzielonych wierszy, razem z wolnymi.
+	 */
+	uint32_t size() const { return liczba.load(); }
 
 	/**
-	 * @brief Ustala wlasciciela konta.
+	 * @brief Wykonuje funkcja(blok, od, do) dla kolejnych fragmentow wierszy [od, do) w obrebie blokow.
 	 *
-	 * @param wlasciciel Wlasciciel konta
+	 * Wewnatrz fragmentu kazda kolumna jest ciagla tablica, wiec petle po niej sa wektoryzowane
+	 * przez kompilator. Nie wolno w tym czasie tworzyc ani usuwac kont.
+	 *
+	 * @param od Pierwszy wiersz
+	 * @param doWiersza Wiersz za ostatnim
+	 * @param funkcja Funkcja wywolywana z (Blok&, pozycja poczatku, pozycja konca)
 	 */
-	void setWlascicielel(string wlasciciel) { this->wlasciciel = wlasciciel; }
+	template <typename Funkcja>
+	void dlaWierszy(size_t od, size_t doWiersza, Funkcja funkcja) const
+	{
+		while (od < doWiersza)
+		{
+			uint32_t poczatek = pozycja(static_cast<uint32_t>(od));
+			size_t koniec = min(doWiersza, od - poczatek + ROZMIAR_BLOKU);
+			funkcja(blok(static_cast<uint32_t>(od)), poczatek, static_cast<uint32_t>(poczatek + (koniec - od)));
+			od = koniec;
+		}
+	}
+
 	/**
-	 * @brief Ustala numer konta.
+	 * @brief Oblicza miesieczne odsetki od salda, zaokraglone tak jak Pieniadze::procent.
 	 *
-	 * @param numer Numer konta
+	 * @param saldo Saldo w groszach
+	 * @param oprocentowanie Oprocentowanie roczne w procentach
+	 * @return Odsetki w groszach
 	 */
-	void setNumerKonta(string numer) { numerKonta = numer; }
+	static int64_t odsetkiMiesieczne(int64_t saldo, float oprocentowanie)
+	{
+		return Pieniadze::procentGroszy(saldo, oprocentowanie, 12);
+	}
 	/**
-	 * @brief Ustala typ konta.
+	 * @brief Sprawdza, czy konto w wierszu nalezy skapitalizowac za podany miesiac.
 	 *
-	 * @param typ Typ konta (np. Osobiste, Oszczędnościowe)
+	 * Warunki sa laczone bez rozgalezien, aby petle po kolumnach mogly byc wektoryzowane.
+	 *
+	 * @param b Blok wiersza
+	 * @param i Pozycja wiersza w bloku
+	 * @param miesiac Miesiac kapitalizacji RRRRMM
 	 */
-	void setTypKonta(string typ) { typKonta = typ; }
+	static bool czyDoKapitalizacji(const Blok& b, uint32_t i, uint32_t miesiac)
+	{
+		return (b.rodzaj[i] == OSZCZEDNOSCIOWE) & (b.miesiacKapitalizacji[i] != 0) & (b.miesiacKapitalizacji[i] < miesiac) &
+			(b.oprocentowanie[i] >= 0); // Ujemne oprocentowanie z importu nie jest kapitalizowane
+
+	}
+
 	/**
-	 * @brief Ustala saldo konta.
+	 * @brief Oznacza wiersz jako zmieniony.
 	 *
-	 * @param saldo Saldo konta
+	 * Na liste zmian wiersz trafia tylko przy pierwszej zmianie od zapisu, a goraca linia
+	 * znacznika nie jest zapisywana przy kazdej wplacie.
+	 *
+	 * @param wiersz Numer wiersza
 	 */
-	void setSaldoKonta(float saldo)
+	void oznaczZmieniony(uint32_t wiersz)
 	{
-		if (saldo < 0) {
-			cout << "Saldo nie moze byc ujemne." << endl;
-			return;
-		}
-		saldoKonta = saldo;
+		atomic<uint8_t>& zmieniony = blok(wiersz).zmienione[pozycja(wiersz)];
+		if (zmieniony.load(memory_order_relaxed) != 0 || zmieniony.exchange(1, memory_order_relaxed) != 0) return;
+		lock_guard<mutex> lock(blokadaZmian);
+		zmienioneWiersze.push_back(wiersz);
 	}
 	/**
-	 * @brief Wplaca pieniadze na konto.
+	 * @brief Dopisuje do listy zmian wiersze, ktorych znaczniki ustawilo zadanie wsadowe.
 	 *
-	 * @param kwota Kwota do wplaty
-	 * @return true jeśli wplata powiodła się, false w przeciwnym razie
+	 * @param wiersze Wiersze, ktorych znacznik zmienil sie z 0 na 1
 	 */
-	virtual bool wplac(float kwota)
+	void dopiszZmienione(const vector<uint32_t>& wiersze)
 	{
-		if (kwota <= 0) {
-			cout << "Kwota do wplaty musi byc wieksza od zera." << endl;
-			return false;
-		}
-		saldoKonta += kwota;
-		cout << "Wplata zakonczona sukcesem. Nowe saldo: " << saldoKonta << " PLN" << endl;
-		return true;
-
+		if (wiersze.empty()) return;
+		lock_guard<mutex> lock(blokadaZmian);
+		zmienioneWiersze.insert(zmienioneWiersze.end(), wiersze.begin(), wiersze.end());
 	}
 	/**
-	 * @brief Wyplaca pieniadze z konta.
+	 * @brief Oproznia liste zmian, kasujac znaczniki, i wywoluje funkcja(wiersz) dla zmienionych wierszy.
 	 *
-	 * @param kwota Kwota do wyplaty
-	 * @return true jeśli wyplata powiodła się, false w przeciwnym razie
+	 * Wiersze zapisane w miedzyczasie inna droga (znacznik juz skasowany) i powtorzenia sa pomijane.
+	 *
+	 * @param funkcja Funkcja wywolywana z numerem wiersza
 	 */
-	virtual bool wyplac(float kwota)
+	template <typename Funkcja>
+	void oproznijZmienione(Funkcja funkcja)
 	{
-		if (kwota <= 0) {
-			cout << "Kwota do wyplaty musi byc wieksza od zera." << endl;
-			return false;
+		vector<uint32_t> wiersze;
+		{
+			lock_guard<mutex> lock(blokadaZmian);
+			wiersze.swap(zmienioneWiersze);
 		}
-		if (kwota > saldoKonta) {
-			cout << "Niewystarczajace srodki na koncie." << endl;
-			return false;
+		for (uint32_t wiersz : wiersze)
+		{
+			if (blok(wiersz).zmienione[pozycja(wiersz)].exchange(0, memory_order_relaxed) != 0) funkcja(wiersz);
 		}
-		saldoKonta -= kwota;
-		cout << "Wyplata zakonczona sukcesem. Nowe saldo: " <<fixed<<setprecision(2)<<saldoKonta<< " PLN" << endl;
-		return true;
-
+	}
+	/**
+	 * @brief Kasuje znaczniki zmian wszystkich kont, np. po zapisaniu punktu kontrolnego.
+	 */
+	void wyczyscZmienione()
+	{
+		oproznijZmienione([](uint32_t) {});
 	}
 
 	/**
-	 * @brief Wyswietla informacje o koncie.
+	 * @brief Sumuje salda wszystkich kont banku.
 	 *
-	 * Funkcja wyswietla szczegóły konta, takie jak numer konta, typ konta i saldo.
+	 * @return Suma sald
 	 */
-	virtual void wyswietlInformacje() const
+	Pieniadze sumaSald() const
 	{
-		cout << "===== DANE KONTA =====" << endl;
-		cout << "Typ konta: " << getTypKonta() << endl;
-		cout << "Numer konta: " << getNumerKonta() << endl;
-		cout << "Saldo: " << fixed << setprecision(2) << getSaldoKonta() << "PLN" << endl;
-		cout << "======================" << endl;
+		atomic<int64_t> suma(0);
+		wykonajRownolegle(size(), [&](size_t od, size_t doWiersza)
+		{
+			int64_t czesc = 0;
+			dlaWierszy(od, doWiersza, [&czesc](const Blok& b, uint32_t poczatek, uint32_t koniec)
+			{
+				int64_t s = 0;
+				for (uint32_t i = poczatek; i < koniec; i++) s += b.saldo[i].load(memory_order_relaxed); // Wolne wiersze maja saldo 0
+				czesc += s;
+			});
+			suma += czesc;
+		});
+		return Pieniadze::zGroszy(suma.load());
 	}
 };
 
 /**
- * @class Transakcja
- * @brief Reprezentuje transakcje.
+ * @class Kalendarz
+ * @brief Biezaca data wspolna dla calego programu.
  *
- * Klasa przechowuje dane o transakcji, takie jak kwota, data, typ transakcji oraz zaangażowane konto.
+ * Sprawdzenia waznosci kart, aktywnosci lokat i terminu kapitalizacji porownuja swoja date
+ * z zapamietanym miesiacem zamiast wywolywac time i localtime_s przy kazdym sprawdzeniu.
+ * Data jest odswiezana na zadanie - przed kazda operacja wybrana z menu i przed zadaniami
+ * wsadowymi - wiec cala operacja widzi ten sam dzien. Odczyty sa atomowe i nie wymagaja blokady.
  */
-class Transakcja
+class Kalendarz
 {
 private:
-	float kwota; ///< Kwota transakcji
-	string typTransakcji; ///< Typ transakcji (np. Wpłata, wypłata, przelew)
-	string dataTransakcji; ///< Data transakcji
-	string kontoNadawcy; ///< Numer konta nadawcy
-	string kontoOdbiorcy; ///< Numer konta odbiorcy
+	atomic<uint32_t> miesiac; ///< Biezacy miesiac RRRRMM
+	atomic<uint32_t> dzien; ///< Biezacy dzien RRRRMMDD
+
 public:
+	Kalendarz() : miesiac(0), dzien(0) { odswiez(); }
+	Kalendarz(const Kalendarz&) = delete;
+	Kalendarz& operator=(const Kalendarz&) = delete;
+
 	/**
-	 * @brief Domyslny konstruktor klasy Transakcja.
-	 *
-	 * Inicjalizuje obiekt Transakcja z domyslnymi wartosciami.
-	 */
-	Transakcja() = default;
-	/**
-	 * @brief  Ustala kwote transakcji.
-	 *
-	 * @param kwota Kwota transakcji
+	 * @brief Zwraca kalendarz wspolny dla calego programu.
 	 */
-	void setKwota(float kwota)
+	static Kalendarz& globalny()
 	{
-		if (kwota < 0) {
-			cout << "Kwota transakcji nie moze byc ujemna." << endl;
-			return;
-		}
-		this->kwota = kwota;
+		static Kalendarz kalendarz;
+		return kalendarz;
 	}
+
 	/**
-	 * @brief Ustala typ transakcji.
-	 *
-	 * @param typTransakcji Typ transakcji (np. Wpłata, wypłata, przelew)
+	 * @brief Odczytuje biezaca date z zegara systemowego.
 	 */
-	void setTypTransakcji(const string &typTransakcji)
+	void odswiez()
 	{
-		if (typTransakcji != "wplata" && typTransakcji != "wyplata" && typTransakcji != "przelew") {
-			cout << "Niepoprawny typ transakcji." << endl;
-			return;
-		}
-		this->typTransakcji = typTransakcji;
+		time_t now = time(nullptr);
+		tm today;
+		localtime_s(&today, &now);
+		uint32_t nowyMiesiac = static_cast<uint32_t>((today.tm_year + 1900) * 100 + today.tm_mon + 1);
+		miesiac.store(nowyMiesiac, memory_order_relaxed);
+		dzien.store(nowyMiesiac * 100 + static_cast<uint32_t>(today.tm_mday), memory_order_relaxed);
 	}
+
 	/**
-	 * @brief Ustala konto nadawcy.
+	 * @brief Zamienia date "MMRR", "MMRRRR" lub "MM/RRRR" na liczbe RRRRMM.
 	 *
-	 * @param kontoNadawcy Numer konta nadawcy
+	 * @param data Data w jednym z formatow
+	 * @return Data RRRRMM lub 0, jesli data jest niepoprawna
 	 */
-	void setKontoNadawcy(const string &kontoNadawcy)
+	static uint32_t spakujMiesiac(const string& data)
 	{
-		if (kontoNadawcy.empty() && typTransakcji == "przelew")
+		bool pelnyRok = data.length() == 7 && data[2] == '/';
+		if (data.length() != 4 && data.length() != 6 && !pelnyRok) return 0;
+		uint32_t miesiac = 0, rok = 0;
+		for (size_t i = 0; i < data.length(); i++)
 		{
-			throw Error("Niepoprawny numer konta nadawcy.");
+			if (i == 2 && pelnyRok) continue;
+			if (data[i] < '0' || data[i] > '9') return 0;
+			if (i < 2) miesiac = miesiac * 10 + (data[i] - '0');
+			else rok = rok * 10 + (data[i] - '0');
 		}
-		this->kontoNadawcy = kontoNadawcy;
+		if (miesiac < 1 || miesiac > 12) return 0;
+		if (data.length() == 4) rok += 2000;
+		return rok * 100 + miesiac;
 	}
 	/**
-	 * @brief Ustala konto odbiorcy.
+	 * @brief Zamienia liczbe RRRRMM na tekst "MM/RRRR" do wyswietlenia i zapisu.
 	 *
-	 * @param kontoOdbiorcy Numer konta odbiorcy
+	 * @param miesiac Data RRRRMM
+	 * @return Data MM/RRRR lub pusty tekst dla 0
 	 */
-	void setKontoOdbiorcy(const string &kontoOdbiorcy)
+	static string formatujMiesiac(uint32_t miesiac)
 	{
-		if (kontoOdbiorcy.empty() && typTransakcji == "przelew")
-		{
-			throw Error("Niepoprawny numer konta odbiorcy.");
-		}
-		this->kontoOdbiorcy = kontoOdbiorcy;
+		if (miesiac == 0) return string();
+		uint32_t rok = miesiac / 100 % 10000;
+		const char tekst[7] = {
+			static_cast<char>('0' + miesiac % 100 / 10), static_cast<char>('0' + miesiac % 10), '/',
+			static_cast<char>('0' + rok / 1000), static_cast<char>('0' + rok / 100 % 10),
+			static_cast<char>('0' + rok / 10 % 10), static_cast<char>('0' + rok % 10) };
+		return string(tekst, sizeof(tekst));
 	}
 
-	void setDataTransakcji(const string& dataTransakcji)
-	{
-		if (dataTransakcji.length() == 4) // Format "MMRR"
-		{
-			this->dataTransakcji = dataTransakcji;
-		}
-		else if (dataTransakcji.length() == 7 && dataTransakcji[2] == '/') // Format "MM/YYYY"
-		{
-			this->dataTransakcji = dataTransakcji.substr(0, 2) + dataTransakcji.substr(5, 2);
-		}
-		else
-		{
-			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
-		}
-	}
 	/**
-	* @brief Zwraca bieżącą datę w formacie "DD-MM-YYYY".
-	*
-	* @return Bieżąca data w formacie "DD-MM-YYYY"
-	*/
-	string getAktualnaData() const
-	{
-		time_t now = time(nullptr);
-		tm today;
-		localtime_s(&today, &now);
+	 * @brief Zwraca biezacy miesiac.
+	 *
+	 * @return Miesiac RRRRMM
+	 */
+	uint32_t getMiesiac() const { return miesiac.load(memory_order_relaxed); }
+	/**
+	 * @brief Zwraca biezacy dzien.
+	 *
+	 * @return Dzien RRRRMMDD
+	 */
+	uint32_t getDzien() const { return dzien.load(memory_order_relaxed); }
+};
 
-		ostringstream ss;
+/**
+ * @class Karta
+ * @brief Reprezentuje karte.
+ *
+ *
+ *  Klasa przechowuje podstawowe dane i funkcje zwiazane z kartami
+ */
+class Karta {
+private:
+	string numerKarty; ///< Numer karty
+	uint32_t miesiacWaznosci = 0; ///< Data waznosci karty RRRRMM (0 - niepoprawna)
+	string kodCVC; ///< Kod CVC karty
+	string pin; ///< Pin karty
+	atomic<bool> zmieniona{ true }; ///< Czy karta zmienila sie od ostatniego zapisu (ustawiane tez przez rownolegle autoryzacje)
+protected:
+	/**
+	 * @brief Oznacza karte jako wymagajaca zapisu.
+	 */
+	void oznaczZmiane() { if (!zmieniona.load(memory_order_relaxed)) zmieniona.store(true, memory_order_relaxed); }
+public:
+	/**
+	 * @brief Konstruktor klasy Karta.
+	 *
+	 * Inicjalizuje obiekt Karta z podanymi parametrami.
+	 *
+	 * @param numer Numer karty
+	 * @param data Data waznosci karty
+	 * @param kod Kod CVC karty
+	 */
+	Karta(string numer, string data, string kod) {
+		this->numerKarty = numer;
+		this->miesiacWaznosci = Kalendarz::spakujMiesiac(data); // Niepoprawna data - karta niewazna
+		this->kodCVC = kod;
 
-		ss << put_time(&today, "%d-%m-%Y %H:%M:%S");
-		return ss.str();
 	}
 	/**
-	 * @brief Zwraca kwote transakcji.
-	 *
-	 * @return Kwota transakcji
+	 * @brief Destruktor wirtualny - karty sa usuwane przez wskaznik na klase bazowa.
 	 */
-	float getKwota() const { return kwota; }
+	virtual ~Karta() = default;
 	/**
-	 * @brief Zwraca typ transakcji.
+	 * @brief Zwraca numer karty.
 	 *
-	 * @return Typ transakcji (np. Wpłata, wypłata, przelew)
+	 * @return Numer karty
 	 */
-	string getTypTransakcji() const { return typTransakcji; }
+	string getNumerKarty() const { return numerKarty; }
 	/**
-	 * @brief Zwraca date transakcji.
+	 * @brief Zwraca date waznosci karty.
 	 *
-	 * @return Data transakcji
+	 * @return Data waznosci karty
 	 */
-	string getDataTransakcji() const { return dataTransakcji; }
+	string getDataWaznosci() const { return Kalendarz::formatujMiesiac(miesiacWaznosci); }
 	/**
-	 * @brief Zwraca numer konta nadawcy.
+	 * @brief Zwraca date waznosci karty jako liczbe RRRRMM.
 	 *
-	 * @return Numer konta nadawcy
+	 * @return Data waznosci RRRRMM lub 0, jesli data jest niepoprawna
 	 */
-	string getKontoNadawcy() const { return kontoNadawcy; }
+	uint32_t getMiesiacWaznosci() const { return miesiacWaznosci; }
 	/**
-	 * @brief Zwraca numer konta odbiorcy.
+	 * @brief Zwraca kod CVC karty.
 	 *
-	 * @return Numer konta odbiorcy
+	 * @return Kod CVC karty
 	 */
-	string getKontoOdbiorcy() const { return kontoOdbiorcy; }
+	string getKodCVC() const { return kodCVC; }
 	/**
-	 * @ brief Ustala szczegóły transakcji.
+	 * @brief Ustala numer karty.
 	 *
-	 * Funckja ustala szczegóły transakcji, takie jak kwota, typ transakcji, data transakcji oraz numery kont nadawcy i odbiorcy.
+	 * @param numer Numer karty
 	 */
-	void szczegolyTransakcji()
-	{
-		cout << "Podaj kwote transakcji: ";
-		float kwotaWpisana;
-		cin >> kwotaWpisana;
-		setKwota(kwotaWpisana);
-
-		cout << "Podaj typ transakcji (wplata/wypata/przelew): ";
-		string typTransakcjiWpisany;
-		cin >> typTransakcjiWpisany;
-		setTypTransakcji(typTransakcjiWpisany);
-
-		dataTransakcji = getAktualnaData();
-
-		if (typTransakcji == "przelew")
-		{
-			cout << "Podaj numer konta nadawcy: ";
-			cin >> kontoNadawcy;
-			cout << "Podaj numer konta odbiorcy: ";
-			cin >> kontoOdbiorcy;
-		}
-	}
+	void setNumerKarty(string numer) { numerKarty = numer; oznaczZmiane(); }
 	/**
-	 * @brief Wyświetla szczegóły transakcji.
+	 * @brief Ustala date waznosci karty.
 	 *
-	 * Funckja wyświetla szczegóły transakcji, takie jak kwota, typ transakcji, data transakcji oraz numery kont nadawcy i odbiorcy.
+	 * @param data Data waznosci karty
 	 */
-	void wyswietlSzczegolyTransakcji() const
+	void setDataWaznosci(string data)
 	{
-		cout << "===== SZCZEGOLY TRANSAKCJI =====" << endl;
-		cout << "Data transakcji: " << getDataTransakcji() << endl;
-		cout << "Typ transakcji: " << getTypTransakcji() << endl;
-		cout << "Kwota: " << fixed << setprecision(2) << getKwota() << " PLN" << endl;
-		if (typTransakcji == "przelew")
+		uint32_t miesiac = Kalendarz::spakujMiesiac(data);
+		if (miesiac == 0)
 		{
-			cout << "Konto nadawcy: " << getKontoNadawcy() << endl;
-			cout << "Konto odbiorcy: " << getKontoOdbiorcy() << endl;
+			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
 		}
-		cout << "===============================" << endl;
+		miesiacWaznosci = miesiac;
+		oznaczZmiane();
 	}
-};
-
-/**
- * @class KartaDebetowa
- * @brief Reprezentuje karte debetowa.
- * @extends Karta
- *
- * Implementacja konkretnego typu karty - karty debetowej,
- * która jest powiązana z kontem bankowym i posiada dzienny limit transakcji.
- */
-class KartaDebetowa : public Karta {
-private:
-	string powiazaneKonto; ///< Powiązane konto bankowe
-	float dziennyLimit; ///< Dzienny limit transakcji
-public:
 	/**
-	 * @brief Konstruktor klasy KartaDebetowa.
+	 * @brief Ustala date waznosci karty w postaci RRRRMM (np. z migawki binarnej).
 	 *
-	 * Inicjalizuje obiekt KartaDebetowa z podanymi parametrami.
+	 * @param miesiac Data RRRRMM
+	 */
+	void setMiesiacWaznosci(uint32_t miesiac) { miesiacWaznosci = miesiac; oznaczZmiane(); }
+	/**
+	 * @brief Ustala kod CVC karty.
 	 *
-	 * @param numer Numer karty
-	 * @param data Data waznosci karty
 	 * @param kod Kod CVC karty
-	 * @param powiazaneKonto Powiązane konto bankowe
-	 * @param limit Dzienny limit transakcji
 	 */
-	KartaDebetowa(string numer, string data, string kod, string powiazaneKonto, float limit)
-		: Karta(numer, data, kod), powiazaneKonto(powiazaneKonto), dziennyLimit(limit) {}
+	void setKodCVC(string kod) { kodCVC = kod; oznaczZmiane(); }
 
 	/**
-	 * @brief Zwraca typ karty
-	 * @return Typ karty
+	* @brief Ustala pin karty.
+	*
+	* @param nowyPin Pin karty
+	*/
+	void setPin(const string& nowyPin) {
+		if (nowyPin.length() == 4) {  // Weryfikacja długości PINu
+			pin = nowyPin;
+			oznaczZmiane();
+		}
+		else {
+			throw Error(", PIN musi miec 4 cyfry");
+		}
+	}
+	/**
+	 * @brief Zwraca typ karty.
 	 *
-	 * Implementacja metody czysto wirtualnej z klasy bazowej Karta.
+	 * @return Typ karty (np. Debetowa, Kredytowa)
 	 */
-	string getTypKarty() const override { return "Debetowa"; }
+	virtual string getTypKarty() const = 0;
+
 	/**
-	 * @brief Pobiera numer powiązanego konta.
-	 * @return Identyfikator konta
-	 */
-	string getPowiazaneKonto() const { return powiazaneKonto; }
+	* @brief Zwraca pin karty.
+	*
+	* @return Pin karty
+	*/
+	string getPin() const { return pin; }
 	/**
-	 * @brief  Pobiera dzienny limit transakcji
-	 * @return Wartość dziennego limitu
+	* @brief Porownuje podany PIN z PINem karty bez kopiowania.
+	*
+	* @param podany PIN podany przy platnosci
+	* @return true jesli PIN jest zgodny
+	*/
+	bool czyPoprawnyPin(const string& podany) const { return pin == podany; }
+	/**
+	 * @brief Sprawdza, czy karta zmienila sie od ostatniego zapisu.
+	 *
+	 * @return true jesli karta wymaga zapisania
 	 */
-	float getDziennyLimit() const { return dziennyLimit; }
+	bool czyZmieniona() const { return zmieniona.load(memory_order_relaxed); }
 	/**
-	 * @brief Ustawia numer powiązanego konta
-	 * @param konto Nowy identyfikator konta
+	 * @brief Oznacza karte jako zapisana.
 	 */
-	void setPowiazaneKonto(string konto) { powiazaneKonto = konto; }
+	void oznaczZapisana() { zmieniona.store(false, memory_order_relaxed); }
 	/**
-	 * @brief Ustawia dzienny limit transakcji
-	 * @param limit Nowa wartość dziennego limitu
+	 * @brief Sprawdza, czy karta jest wazna.
+	 * @return true jeśli karta jest wazna, false w przeciwnym razie
 	 */
-	void setDziennyLimit(float limit)
+	virtual bool czyWazna() const
 	{
-		if (limit<0)
-		{
-			throw Error("Dzienny limit nie moze byc ujemny.");
-		}
-		dziennyLimit = limit;
+		return miesiacWaznosci >= Kalendarz::globalny().getMiesiac(); // Niepoprawna data (0) nigdy nie jest wazna
 	}
 	/**
-	 * @brief Wykonuje płatność kartą
-	 * @param kwota Kwota transakcji
-	 * @return true jeśli płatność została wykonana pomyślnie, false w przeciwnym razie
+	 * @brief Wyswietla informacje o karcie.
 	 *
-	 * Metoda weryfikuje czy żądana kwota nie przekracza dziennego limitu transakcji
-	 * i czy karta jest ważna, a następnie wykonuje płatność.
+	 * Funkcja wyswietla szczegóły karty, takie jak numer karty, data waznosci, kod CVC oraz status karty.
 	 */
-	bool wykonajPlatnosc(float kwota)
+	virtual void wyswietlInformacje() const
 	{
-		if (kwota<=0)
-		{
-			cerr << "Kwota transakcji musi byc wieksza od zera." << endl;
-			return false;
-		}
-
-		if (!czyWazna())
-		{
-			cerr << "Karta jest niewazna." << endl;
-			return false;
-
-		}
-		if (kwota > dziennyLimit)
-		{
-			cerr << "Kwota transakcji przekracza dzienny limit." << endl;
-			return false;
-		}
-
-		dziennyLimit -= kwota;
-		cout << "Platnosc zakonczona sukcesem. Pozostaly limit: " << dziennyLimit << " PLN" << endl;
-		return true;
+		cout << "===== DANE KARTY =====" << endl;
+		cout << "Typ karty: " << getTypKarty() << endl;
+		cout << "Numer karty: " << getNumerKarty() << endl;
+		cout << "Data waznosci: " << getDataWaznosci() << endl;
+		cout << "Kod CVC: " << getKodCVC() << endl;
+		cout << "Status: " << (czyWazna() ? "Wazna" : "Niewazna") << endl;
+		cout << "======================" << endl;
 	}
 };
+
+
 /**
- * @class KontoOszczednosciowe
- * @brief Reprezentuje konto oszczędnościowe.
+ * @class Lokata
+ * @brief Reprezentuje lokate.
  *
- * Klasa dziedziczy po klasie Konto i dodaje funkcjonalności specyficzne dla kont oszczędnościowych.
+ * Klasa przechowuje kwote, oprocentowanie oraz date oddania.
  */
-class KontoOszczednosciowe : public KontoGlowne {
-private:
-	float oprocentowanie; ///< Oprocentowanie konta oszczędnościowego
-	string dataOstatniejKapitalizacji; ///< Data ostatniej kapitalizacji odsetek
-	int ograniczenieWyplat; ///< Ograniczenie liczby wypłat w miesiącu
-	int wykonaneWyplatywWMiesiacu; ///< Liczba wykonanych wypłat w danym miesiącu
+class Lokata {
+	Pieniadze kwota; ///< Kwota lokaty
+	float oprocentowanie; ///< Oprocentowanie lokaty
+	uint32_t miesiacOddania = 0; ///< Data oddania lokaty RRRRMM (0 - niepoprawna)
+	uint32_t powiazaneKonto = 0; ///< Identyfikator powiązanego konta w SlownikNumerow
+	bool rozliczona = false; ///< Czy lokata zostala juz wyplacona na powiazane konto
+	bool usunieta = false; ///< Czy lokata zostala usunieta razem z kontem (zostaje w wektorze, zeby nie przesuwac indeksow)
+
 public:
 	/**
-	 * @brief Konstruktor klasy KontoOszczednosciowe.
+	 * @brief Konstruktor klasy Lokata.
 	 *
-	 * Inicjalizuje obiekt KontoOszczednosciowe z podanymi parametrami.
+	 * Inicjalizuje obiekt Lokata z podanymi parametrami.
 	 *
-	 * @param numer Numer konta
-	 * @param saldo Saldo konta
-	 * @param oprocentowanie Oprocentowanie konta oszczędnościowego
-	 * @param dataKapitalizacji Data ostatniej kapitalizacji odsetek
-	 * @param limitWyplat Ograniczenie liczby wypłat w miesiącu
+	 * @param kwota Kwota lokaty
+	 * @param oprocentowanie Oprocentowanie lokaty
+	 * @param dataOddania Data oddania lokaty
+	 * @param wlasciciel Wlasciciel lokaty
 	 */
-	KontoOszczednosciowe(string numer, float saldo, float oprocentowanie, string dataKapitalizacji, int limitWyplat)
-		: KontoGlowne(numer, "Oszczednosciowe", saldo), oprocentowanie(oprocentowanie), dataOstatniejKapitalizacji(dataKapitalizacji), ograniczenieWyplat(limitWyplat), wykonaneWyplatywWMiesiacu(0) {}
-
+	Lokata(Pieniadze kwota, float oprocentowanie, const string& dataOddania, string wlasciciel) {
+		this->kwota = kwota;
+		this->oprocentowanie = oprocentowanie;
+		this->miesiacOddania = Kalendarz::spakujMiesiac(dataOddania);
+		this->powiazaneKonto = SlownikNumerow::globalny().dodaj(wlasciciel);
+	}
 	/**
-	 * @brief Zwraca oprocentowanie konta oszczędnościowego.
+	 * @brief Konstruktor domyslny klasy Lokata.
 	 *
-	 * @return Oprocentowanie konta oszczędnościowego
+	 * Inicjalizuje obiekt Lokata z domyslnymi wartosciami.
 	 */
-	float getOprocentowanie() const { return oprocentowanie; }
+	Lokata() = default;
 	/**
-	 * @brief Zwraca datę ostatniej kapitalizacji odsetek.
+	 * @brief Ustala kwote lokaty.
 	 *
-	 * @return Data ostatniej kapitalizacji odsetek
+	 * @param kwota Kwota lokaty
 	 */
-	string getDataOstatniejKapitalizacji() const
+	void setKwota(Pieniadze kwota) { this->kwota = kwota; }
+	/**
+	 * @brief Ustala oprocentowanie lokaty.
+	 *
+	 * @param oprocentowanie Oprocentowanie lokaty
+	 */
+	void setOprocentowanie(float oprocentowanie) { this->oprocentowanie = oprocentowanie; }
+	/**
+	 * @brief Ustala date oddania lokaty.
+	 *
+	 * @param dataOddania Data oddania lokaty w formacie MMRR lub MM/YYYY
+	 * @throws Error Gdy data ma niepoprawny format
+	 */
+	void setDataOddania(const string& dataOddania)
 	{
-		if (dataOstatniejKapitalizacji.length()== 4)
+		uint32_t miesiac = Kalendarz::spakujMiesiac(dataOddania);
+		if (miesiac == 0)
 		{
-			return dataOstatniejKapitalizacji.substr(0, 2) + "/20" + dataOstatniejKapitalizacji.substr(2, 2);
-
+			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
 		}
-		return dataOstatniejKapitalizacji;
+		miesiacOddania = miesiac;
 	}
+	/**
+	 * @brief Ustala date oddania lokaty w postaci RRRRMM (np. z migawki binarnej).
+	 *
+	 * @param miesiac Data RRRRMM
+	 */
+	void setMiesiacOddania(uint32_t miesiac) { this->miesiacOddania = miesiac; }
 
 	/**
-	* @brief Zwraca ograniczenie liczby wypłat w miesiącu.
+	* @brief Ustala konto powiazane z dana lokata.
 	*
-	* @return Ograniczenie liczby wypłat w miesiącu
+	* @param wlasciciel Powiazane konto
 	*/
-	int getOgraniczenieWyplat() const { return ograniczenieWyplat; }
-
+	void setPowiazaneKonto(const string& wlasciciel) { this->powiazaneKonto = SlownikNumerow::globalny().dodaj(wlasciciel); }
 	/**
-	* @brief Zwraca liczbę wykonanych wypłat w danym miesiącu.
+	* @brief Ustala konto powiazane z dana lokata przez identyfikator ze SlownikNumerow.
 	*
-	* @return Liczba wykonanych wypłat w danym miesiącu
+	* @param id Identyfikator powiazanego konta
 	*/
-	int getWykonaneWyplatywWMiesiacu() const { return wykonaneWyplatywWMiesiacu; }
+	void setIdPowiazanegoKonta(uint32_t id) { this->powiazaneKonto = id; }
 	/**
-	 * @brief Ustala oprocentowanie konta oszczędnościowego.
+	* @brief Oznacza lokate jako rozliczona (wyplacona na powiazane konto).
+	*
+	* @param rozliczona Czy lokata jest rozliczona
+	*/
+	void setRozliczona(bool rozliczona) { this->rozliczona = rozliczona; }
+	/**
+	* @brief Oznacza lokate jako usunieta razem z powiazanym kontem.
+	*
+	* Usunieta lokata zostaje na swojej pozycji, wiec indeksy pozostalych lokat
+	* (w dzienniku i harmonogramie wyplat) sie nie zmieniaja.
+	*
+	* @param usunieta Czy lokata jest usunieta
+	*/
+	void setUsunieta(bool usunieta) { this->usunieta = usunieta; }
+	/**
+	 * @brief Zwraca kwote lokaty.
 	 *
-	 * @param oprocentowanie Oprocentowanie konta oszczędnościowego
+	 * @return Kwota lokaty
 	 */
-	void setOprocentowanie(float oprocentowanie)
-	{
-		if (oprocentowanie < 0) {
-			cout << "Oprocentowanie nie moze byc ujemne." << endl;
-			return;
-		}
-		this->oprocentowanie = oprocentowanie;
-	}
+	Pieniadze getKwota() const { return kwota; }
+
 	/**
-	 * @brief Ustala datę ostatniej kapitalizacji odsetek.
+	 * @brief Zwraca oprocentowanie lokaty.
 	 *
-	 * @param dataKapitalizacji Data ostatniej kapitalizacji odsetek
+	 * @return Oprocentowanie lokaty
 	 */
-	void setDataOstatniejKapitalizacji(string data)
-	{
-		if (data.length() == 4) // Format "MMRR"
-		{
-			dataOstatniejKapitalizacji = data;
-		}
-		else if (data.length() == 7 && data[2] == '/') // Format "MM/YYYY"
-		{
-			dataOstatniejKapitalizacji = data.substr(0, 2) + data.substr(5, 2);
-		}
-		else
-		{
-			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
-		}
-	}
+	float getOprocentowanie() const { return oprocentowanie; }
+
 	/**
-	 * @brief Ustala ograniczenie liczby wypłat w miesiącu.
+	 * @brief Zwraca date oddania lokaty.
 	 *
-	 * @param limitWyplat Ograniczenie liczby wypłat w miesiącu
+	 * @return Data oddania lokaty
 	 */
-	void setOgraniczenieWyplat(int limitWyplat)
-	{
-		if (limitWyplat < 0) {
-			cout << "Ograniczenie wypłat nie może być ujemne." << endl;
-			return;
-		}
-		this->ograniczenieWyplat = limitWyplat;
-	}
-
+	string getDataOddania() const { return Kalendarz::formatujMiesiac(miesiacOddania); }
 	/**
-	 * @breif Resetuje licznik wypłat w danym miesiącu.
+	 * @brief Zwraca date oddania lokaty jako liczbe RRRRMM.
 	 *
-	 * Funkcja resetuje licznik wypłat w danym miesiącu do zera.
+	 * @return Data oddania RRRRMM lub 0, jesli data jest niepoprawna
 	 */
-	void resetujLicznikWyplat() {
-		wykonaneWyplatywWMiesiacu = 0;
-	}
-
-	bool czyNalezyKapitalizowac() const
-	{
-		if (dataOstatniejKapitalizacji.length()!=4)
-		{
-			return false; // Niepoprawny format daty
-		}
-		try
-		{
-			time_t now = time(nullptr);
-			tm today;
-			localtime_s(&today, &now);
-
-			int miesiacKapitalizacji = stoi(dataOstatniejKapitalizacji.substr(0, 2));
-			int rokKapitalizacji = 2000 + stoi(dataOstatniejKapitalizacji.substr(2, 2));
-			int miesiacAktualny= today.tm_mon + 1;
-			int rokAktualny = today.tm_year + 1900;
+	uint32_t getMiesiacOddania() const { return miesiacOddania; }
 
-			if (rokAktualny>rokKapitalizacji)
-			{
-				return true;
-			}
-			else if (rokAktualny == rokKapitalizacji && miesiacAktualny > miesiacKapitalizacji)
-			{
-				return true;
-			}
-			return false;
-		}catch (...)
-		{
-			return false; // Niepoprawny format daty
-		}
-	}
 	/**
-	 * @brief Oblicza i dodaje odsetki do konta.
+	 * @brief Zwraca konto powiazane z dana lokata.
 	 *
-	 * @return
+	 * @return Powiazane konto
 	 */
-	float kapitalizujOdsetki()
-	{
-		if (!czyNalezyKapitalizowac())
-		{
-			cout << "Nie minal jeszcze miesiac od ostatniej kapitalizacji." << endl;
-			return 0.0f;
-		}
-
-		float saldo = getSaldoKonta();
-		float odsetki = saldo * (oprocentowanie / 100.0f) / 12.0f; // Miesieczne odsetki
-
-		setSaldoKonta(saldo + odsetki);
-
-		time_t now = time(nullptr);
-		tm today;
-		localtime_s(&today, &now);
-
-		string miesiac = to_string(today.tm_mon + 1);
-		if (miesiac.length() == 1) {
-			miesiac = "0" + miesiac; // Dodaj zero wiodące
-		}
-
-		string rok = to_string((today.tm_year + 1900) % 100); // Dwie ostatnie cyfry roku
-		if (rok.length() == 1) {
-			rok = "0" + rok; // Dodaj zero wiodące
-		}
-		dataOstatniejKapitalizacji = miesiac + rok; // Ustaw nowa date kapitalizacji
-
-		cout << "Kapitalizacja odsetek wykonana pomyslnie." << endl;
-		cout << "Naliczone odsetki: " << fixed << setprecision(2) << odsetki << " PLN" << endl;
-		cout << "Nowe saldo: " << fixed << setprecision(2) << getSaldoKonta() << " PLN" << endl;
+	const string& getPowiazaneKonto() const { return SlownikNumerow::globalny().numer(powiazaneKonto); }
+	/**
+	 * @brief Zwraca identyfikator powiazanego konta w SlownikNumerow.
+	 */
+	uint32_t getIdPowiazanegoKonta() const { return powiazaneKonto; }
+	/**
+	 * @brief Sprawdza czy lokata zostala juz wyplacona na powiazane konto.
+	 */
+	bool czyRozliczona() const { return rozliczona; }
+	/**
+	 * @brief Sprawdza czy lokata zostala usunieta razem z powiazanym kontem.
+	 */
+	bool czyUsunieta() const { return usunieta; }
 
-		return odsetki;
-	}
 	/**
-	 * @brief Wplaca pieniadze na konto oszczędnościowe.
+	 * @brief Sprawdza czy lokata jest aktywna.
 	 *
-	 * @param kwota Kwota do wplaty
-	 * @return true jeśli wplata powiodła się, false w przeciwnym razie
+	 * @return true jeśli lokata jest aktywna, false w przeciwnym razie
 	 */
-	bool wplac(float kwota) override
+	bool czyAktywna() const
 	{
-		return KontoGlowne::wplac(kwota);
+		return !rozliczona && !usunieta && miesiacOddania >= Kalendarz::globalny().getMiesiac(); // Niepoprawna data (0) nigdy nie jest aktywna
 	}
 	/**
-	 * @brief Wyplaca pieniadze z konta oszczędnościowego.
+	 * @brief Oblicza zysk z lokaty.
 	 *
-	 * @param kwota Kwota do wyplaty
-	 * @return true jeśli wyplata powiodła się, false w przeciwnym razie
+	 * @return Zysk z lokaty, zaokraglony do grosza
 	 */
-	bool wyplac(float kwota) override
+	Pieniadze obliczZysk() const
 	{
-		if (wykonaneWyplatywWMiesiacu >= ograniczenieWyplat)
-		{
-			cout << "Przekroczono limit wyplat w tym miesiacu (" << ograniczenieWyplat << ")." << endl;
-			return false;
-		}
-
-		bool wyplataUdana = KontoGlowne::wyplac(kwota);
-
-		if (wyplataUdana)
-		{
-			wykonaneWyplatywWMiesiacu++;
-			cout << "Dostepna liczba wyplat w tym, miesiacu: " << ograniczenieWyplat - wykonaneWyplatywWMiesiacu << endl;
-
-		}
-		return wyplataUdana;
+		if (oprocentowanie < 0) return Pieniadze(); // Oprocentowanie nie moze byc ujemne
+		return kwota.procent(oprocentowanie);
 	}
 
-	void wyswietlInformacje() const override
-	{
-		cout << "===== DANE KONTA OSZCZEDNOSCIOWEGO =====" << endl;
-		cout << "Typ konta: " << getTypKonta() << endl;
-		cout << "Numer konta: " << getNumerKonta() << endl;
-		cout << "Saldo: " << fixed << setprecision(2) << getSaldoKonta() << " PLN" << endl;
+	/**
+ * @brief Wyswietla informacje o lokacie.
+ *
+ * Funkcja wyswietla szczegóły lokaty, takie jak kwota, oprocentowanie, data oddania,
+ * zysk roczny oraz status lokaty.
+ */
+	void wyswietlInformacje() const
+	{
+		cout << "===== DANE LOKATY =====" << endl;
+		cout << "Kwota: " << fixed<<setprecision(2)<<getKwota() <<"PLN"<< endl;
 		cout << "Oprocentowanie: " << getOprocentowanie() << "%" << endl;
-		cout << "Data ostatniej kapitalizacji: " << getDataOstatniejKapitalizacji() << endl;
-		cout << "Limit wyplat miesiecznie: " << getOgraniczenieWyplat() << endl;
-		cout << "Liczba wyplat w tym miesiacu: " << getWykonaneWyplatywWMiesiacu() << "/" << getOgraniczenieWyplat() << endl;
-		cout << "Pozostale wyplaty w tym miesiacu: " << getOgraniczenieWyplat() - getWykonaneWyplatywWMiesiacu() << endl;
-		cout << "========================================" << endl;
-
+		cout << "Data oddania: " << getDataOddania() << endl;
+		cout << "Zysk roczny: " << obliczZysk() << " PLN" << endl;
+		cout << "Status: " << (rozliczona ? "Rozliczona" : czyAktywna() ? "Aktywna" : "Nieaktywna") << endl;
+		cout << "Konto powiazane: " << getPowiazaneKonto() << endl;
+		cout << "======================" << endl;
 	}
-
 };
+
 /**
- * @class Klient
- * @brief Reprezentuje klienta banku.
+ * @class KontoGlowne
+ * @brief Reprezentuje konto.
  *
  *
- *  Klasa przechowuje dane osobowe oraz udostepnia podstawowe funkcje zwiazane z uzytkownikiem
+ *  Klasa przechowuje podtsawowe dane dane i funkcje zwiazane z kontami.
+ *  Numer, saldo i znacznik zmiany leza w wierszu MagazynKont, obiekt jest ich widokiem.
  */
-class Klient
-{
+class KontoGlowne {
 private:
-	string imie; ///< Imie klienta
-	string nazwisko; ///< Nazwisko klienta
-	string pesel; ///< Numer PESEL klienta
-	string login; ///< Login klienta
-	string haslo; ///< Haslo klienta
-	
-
-	vector<KontoGlowne*> kontaUzytkownika; ///< Tablica przechowujaca konta uzytkownika
-	vector<Karta*> kartyUzytkownika; ///< Tablica przechowujaca karty uzytkownika
-	vector<Lokata> lokatyUzytkownika; ///< Tablica przechowujaca lokaty uzytkownika
+	uint32_t wiersz; ///< Wiersz konta w MagazynKont
+	string typKonta; ///< Typ konta (np. Osobiste, Oszczędnościowe)
+	string wlasciciel; ///< Właściciel konta
 
-public:
+protected:
 	/**
-	 *@brief Domyslny konstruktor klasy Klient
-	 *
-	 * Inicjalizuje obiekt Klient z domyslnymi wartosciami.
+	 * @brief Zwraca blok magazynu z wierszem konta.
 	 */
-	Klient() = default;
-
+	MagazynKont::Blok& kolumny() const { return MagazynKont::globalny().blok(wiersz); }
 	/**
-	* @brief Konstruktor parametryczny klasy Klient.
-	*
-	* Inicjalizuje obiekt Klient z podanymi parametrami.
-	*
-	* @param imie Imie klienta
-	* @param nazwisko Nazwisko klienta
-	* @param pesel Numer PESEL klienta
-	* @param login Login klienta
-	* @param haslo Haslo klienta
-	*/
-	Klient(string imie, string nazwisko, string pesel, string login, string haslo)
-	{
-		this->imie = imie;
-		this->nazwisko = nazwisko;
-		this->pesel = pesel;
-		this->login = login;
-		this->haslo = haslo;
-	}
-
+	 * @brief Zwraca pozycje wiersza konta w bloku.
+	 */
+	uint32_t pozycja() const { return MagazynKont::pozycja(wiersz); }
 	/**
-	 * @brief Destruktor klasy Klient.
+	 * @brief Oznacza konto jako wymagajace zapisu.
+	 */
+	void oznaczZmiane() { MagazynKont::globalny().oznaczZmieniony(wiersz); }
+	/**
+	 * @brief Zmniejsza saldo petla CAS, jesli nie zejdzie ono ponizej zera.
 	 *
-	 * Uwalnia zasoby zajmowane przez konta i karty uzytkownika.
+	 * @param grosze Kwota w groszach
+	 * @param saldoPo Saldo po obciazeniu (lub biezace saldo przy odmowie)
+	 * @return false jesli saldo jest niewystarczajace
 	 */
-	~Klient()
+	bool zmniejszSaldo(int64_t grosze, int64_t& saldoPo)
 	{
-		for (auto& konto : kontaUzytkownika)
+		atomic<int64_t>& saldo = kolumny().saldo[pozycja()];
+		int64_t biezace = saldo.load(memory_order_relaxed);
+		do
 		{
-			delete konto;
-		}
-		kontaUzytkownika.clear();
+			if (biezace < grosze)
+			{
+				saldoPo = biezace;
+				return false;
+			}
+		} while (!saldo.compare_exchange_weak(biezace, biezace - grosze, memory_order_relaxed));
+		saldoPo = biezace - grosze;
+		return true;
+	}
 
-		for (auto& karta : kartyUzytkownika)
-		{
-			delete karta;
-		}
-		kartyUzytkownika.clear();
+public:
+	/**
+	 * @brief Konstruktor klasy Konto.
+	 *
+	 * Inicjalizuje obiekt Konto z podanymi parametrami.
+	 *
+	 * @param numer Numer konta
+	 * @param typ Typ konta (np. Osobiste, Oszczędnościowe)
+	 * @param saldo Saldo konta
+	 */
+	KontoGlowne(string numer, string typ, Pieniadze saldo) : KontoGlowne() {
+			kolumny().idKonta[pozycja()] = SlownikNumerow::globalny().dodaj(numer);
+			this->typKonta = typ;
+			kolumny().saldo[pozycja()].store(saldo.getGrosze(), memory_order_relaxed);
 	}
 	/**
-	 *@brief Ustala imie klienta.
+	 * @brief Konstruktor domyslny klasy Konto.
 	 *
-	 *@param imie Imie klienta
+	 * Inicjalizuje obiekt Konto z domyslnymi wartosciami.
 	 */
-	void setImie(string imie) { this->imie = imie; }
+	KontoGlowne() : wiersz(MagazynKont::globalny().przydziel(MagazynKont::GLOWNE)) {}
 	/**
-	 * @brief Ustala nazwisko klienta.
+	 * @brief Destruktor wirtualny - konta sa usuwane przez wskaznik na klase bazowa.
 	 *
-	 * @param nazwisko Nazwisko klienta
+	 * Zwalnia wiersz konta w MagazynKont.
 	 */
-	void setNazwisko(string nazwisko) { this->nazwisko = nazwisko; }
+	virtual ~KontoGlowne() { MagazynKont::globalny().zwolnij(wiersz); }
+	KontoGlowne(const KontoGlowne&) = delete;
+	KontoGlowne& operator=(const KontoGlowne&) = delete;
 	/**
-	 * @brief Ustala PESEL klienta.
+	 * @brief Zwraca numer konta.
 	 *
-	 * @param pesel Numer PESEL klienta
+	 * @return Numer konta
 	 */
-	void setPesel(string pesel) { this->pesel = pesel; }
+	const string& getNumerKonta() const { return SlownikNumerow::globalny().numer(getIdKonta()); }
 	/**
-	 * @brief Ustala login klienta.
+	 * @brief Zwraca identyfikator numeru konta w SlownikNumerow.
+	 */
+	uint32_t getIdKonta() const { return kolumny().idKonta[pozycja()]; }
+	/**
+	 * @brief Zwraca wiersz konta w MagazynKont.
+	 */
+	uint32_t getWiersz() const { return wiersz; }
+	/**
+	 * @brief Zwraca typ konta.
 	 *
-	 * @param login Login klienta
+	 * @return Typ konta (np. Osobiste, Oszczędnościowe)
 	 */
-	void setLogin(string login) { this->login = login; }
+	string getTypKonta() const { return typKonta; }
+
 	/**
-	 * @brief Ustala haslo klienta.
+	 * @brief Zwraca saldo konta.
 	 *
-	 * @param haslo Haslo klienta
+	 * @return Saldo konta
 	 */
-	void setHaslo(string haslo) { this->haslo = haslo; }
+	Pieniadze getSaldoKonta() const { return Pieniadze::zGroszy(kolumny().saldo[pozycja()].load(memory_order_relaxed)); }
 	/**
-	 * @brief Zwraca imie klienta.
+	 * @brief Zwraca wlasciciela konta.
 	 *
-	 * @return Imie klienta
+	 * @return Wlasciciel konta
 	 */
-	string getImie() const { return imie; }
+	string getWlasciciel() const { return wlasciciel; }
 	/**
-	 * @brief Zwraca nazwisko klienta.
+	 * @brief Sprawdza, czy konto zmienilo sie od ostatniego zapisu.
 	 *
-	 * @return Nazwisko klienta
+	 * @return true jesli konto wymaga zapisania
 	 */
-	string getNazwisko() const { return nazwisko; }
+	bool czyZmienione() const { return kolumny().zmienione[pozycja()].load(memory_order_relaxed) != 0; }
 	/**
-	 * @brief Zwraca PESEL klienta.
+	 * @brief Oznacza konto jako zapisane.
+	 */
+	void oznaczZapisane() { kolumny().zmienione[pozycja()].store(0, memory_order_relaxed); }
+
+	/**
+	 * @brief Ustala wlasciciela konta.
 	 *
-	 * @return Numer PESEL klienta
+	 * @param wlasciciel Wlasciciel konta
 	 */
-	string getPesel() const { return pesel; }
+	void setWlascicielel(string wlasciciel) { this->wlasciciel = wlasciciel; oznaczZmiane(); }
 	/**
-	 * @brief Zwraca login klienta.
+	 * @brief Ustala numer konta.
 	 *
-	 * @return Login klienta
+	 * @param numer Numer konta
 	 */
-	string getLogin() const { return login; }
+	void setNumerKonta(string numer) { setIdKonta(SlownikNumerow::globalny().dodaj(numer)); }
 	/**
-	 * @brief Zwraca haslo klienta.
+	 * @brief Ustala numer konta przez identyfikator ze SlownikNumerow.
 	 *
-	 * @return Haslo klienta
+	 * @param id Identyfikator numeru konta
 	 */
-	string getHaslo() const { return haslo; }
-
+	void setIdKonta(uint32_t id) { kolumny().idKonta[pozycja()] = id; oznaczZmiane(); }
 	/**
-	 * @brief Dodaje konto do listy kont uzytkownika.
+	 * @brief Ustala typ konta.
 	 *
-	 * @param konto Wskaznik na obiekt konta do doania
+	 * @param typ Typ konta (np. Osobiste, Oszczędnościowe)
 	 */
-	void dodajKonto(KontoGlowne* konto)
+	void setTypKonta(string typ) { typKonta = typ; oznaczZmiane(); }
+	/**
+	 * @brief Ustala saldo konta.
+	 *
+	 * @param saldo Saldo konta
+	 */
+	void setSaldoKonta(Pieniadze saldo)
 	{
-		kontaUzytkownika.push_back(konto);
+		if (saldo.czyUjemna()) {
+			cout << "Saldo nie moze byc ujemne." << endl;
+			return;
+		}
+		kolumny().saldo[pozycja()].store(saldo.getGrosze(), memory_order_relaxed);
+		oznaczZmiane();
 	}
-
 	/**
-	* @brief Dodaje karte do listy kart uzytkownika.
-	*
-	* @param karta Wskaznik na obiekt karty do dodania
-	*/
-	void dodajKarte(Karta* karta)
+	 * @brief Wplaca pieniadze na konto.
+	 *
+	 * @param kwota Kwota do wplaty
+	 * @return true jeśli wplata powiodła się, false w przeciwnym razie
+	 */
+	virtual bool wplac(Pieniadze kwota)
 	{
-		kartyUzytkownika.push_back(karta);
-	}
+		if (!kwota.czyDodatnia()) {
+			cout << "Kwota do wplaty musi byc wieksza od zera." << endl;
+			return false;
+		}
+		int64_t saldoPo = kolumny().saldo[pozycja()].fetch_add(kwota.getGrosze(), memory_order_relaxed) + kwota.getGrosze();
+		oznaczZmiane();
+		cout << "Wplata zakonczona sukcesem. Nowe saldo: " << Pieniadze::zGroszy(saldoPo) << " PLN" << endl;
+		return true;
 
+	}
 	/**
-	* @brief Dodaje lokate do listy lokat uzytkownika.
-	*
-	* @param lokata Obiekt lokaty do dodania
-	*/
-	void dodajLokate(const Lokata& lokata)
+	 * @brief Wyplaca pieniadze z konta.
+	 *
+	 * @param kwota Kwota do wyplaty
+	 * @return true jeśli wyplata powiodła się, false w przeciwnym razie
+	 */
+	virtual bool wyplac(Pieniadze kwota)
 	{
-		lokatyUzytkownika.push_back(lokata);
-	}
+		if (!kwota.czyDodatnia()) {
+			cout << "Kwota do wyplaty musi byc wieksza od zera." << endl;
+			return false;
+		}
+		int64_t saldoPo;
+		if (!zmniejszSaldo(kwota.getGrosze(), saldoPo)) {
+			cout << "Niewystarczajace srodki na koncie." << endl;
+			return false;
+		}
+		oznaczZmiane();
+		cout << "Wyplata zakonczona sukcesem. Nowe saldo: " <<fixed<<setprecision(2)<<Pieniadze::zGroszy(saldoPo)<< " PLN" << endl;
+		return true;
 
+	}
 	/**
-	* @brief Zwraca liste kont uzytkownika.
-	*
-	* @return Wektor wskaznikow na konta uzytkownika
-	*/
-	vector<KontoGlowne*>& getKontaUzytkownika()
+	 * @brief Uznaje konto kwota przelewu przychodzacego.
+	 *
+	 * W przeciwienstwie do wplac nie wypisuje salda, ktorego nadawca nie powinien widziec.
+	 * Uznanie to jedno fetch_add, wiec konta przyjmujace wiele wplat naraz (np. rozliczeniowe
+	 * konta sprzedawcow) nie wymagaja zadnej blokady.
+	 *
+	 * @param kwota Kwota przelewu, juz sprawdzona przy obciazeniu nadawcy
+	 */
+	void uznaj(Pieniadze kwota)
 	{
-		return kontaUzytkownika;
+		kolumny().saldo[pozycja()].fetch_add(kwota.getGrosze(), memory_order_relaxed);
+		oznaczZmiane();
 	}
-
 	/**
-	 * @brief Zwraca liste kart uzytkownika.
+	 * @brief Obciaza konto bez wypisywania komunikatow (autoryzacja platnosci karta, silnik przelewow).
 	 *
-	 * @return Wektor wskaznikow na katry klientow
+	 * @param kwota Kwota dodatnia
+	 * @return false jesli saldo jest niewystarczajace
 	 */
-	vector<Karta*>& getKartyUzytkownika()
+	virtual bool obciaz(Pieniadze kwota)
 	{
-		return kartyUzytkownika;
+		int64_t saldoPo;
+		if (!zmniejszSaldo(kwota.getGrosze(), saldoPo)) return false;
+		oznaczZmiane();
+		return true;
 	}
 
 	/**
-	* @brief Zwraca liste lokat uzytkownika.
-	*
-	* @return Wektor lokat klienta
-	*/
-	vector<Lokata>& getLokatyUzytkownika()
+	 * @brief Wyswietla informacje o koncie.
+	 *
+	 * Funkcja wyswietla szczegóły konta, takie jak numer konta, typ konta i saldo.
+	 */
+	virtual void wyswietlInformacje() const
 	{
-		return lokatyUzytkownika;
+		cout << "===== DANE KONTA =====" << endl;
+		cout << "Typ konta: " << getTypKonta() << endl;
+		cout << "Numer konta: " << getNumerKonta() << endl;
+		cout << "Saldo: " << fixed << setprecision(2) << getSaldoKonta() << "PLN" << endl;
+		cout << "======================" << endl;
 	}
+};
+
+/// Rodzaj transakcji; wartosci sa zapisywane w migawce binarnej
+enum class TypTransakcji : uint8_t { BRAK = 0, WPLATA, WYPLATA, PRZELEW, ODSETKI };
 
+/**
+ * @class Transakcja
+ * @brief Reprezentuje transakcje.
+ *
+ * Klasa przechowuje dane o transakcji, takie jak kwota, data, typ transakcji oraz zaangażowane konto.
+ * Rekord zajmuje 32 bajty: numery kont sa identyfikatorami ze SlownikNumerow, data to liczba RRRRMM,
+ * a typ to TypTransakcji, wiec historia nie wymaga zadnych alokacji na transakcje.
+ */
+class Transakcja
+{
+private:
+	Pieniadze kwota; ///< Kwota transakcji
+	int64_t znacznikCzasu = 0; ///< Moment wykonania transakcji w sekundach od 1970 roku (0 - nieznany)
+	uint32_t kontoNadawcy = 0; ///< Identyfikator numeru konta nadawcy w SlownikNumerow
+	uint32_t kontoOdbiorcy = 0; ///< Identyfikator numeru konta odbiorcy w SlownikNumerow
+	uint32_t miesiacTransakcji = 0; ///< Data transakcji jako liczba RRRRMM
+	TypTransakcji typTransakcji = TypTransakcji::BRAK; ///< Typ transakcji (wplata, wyplata, przelew)
 
 	/**
-	 * @brief Znajduje konto po numerze.
+	 * @brief Zwraca nazwe typu transakcji uzywana w plikach i na ekranie.
+	 */
+	static const string& nazwaTypu(TypTransakcji typ)
+	{
+		static const string nazwy[] = { "", "wplata", "wyplata", "przelew", "odsetki" };
+		return nazwy[static_cast<size_t>(typ)];
+	}
+public:
+	/**
+	 * @brief Domyslny konstruktor klasy Transakcja.
 	 *
-	 * @param numerKonta Numer konta do znalezienia
+	 * Inicjalizuje obiekt Transakcja z domyslnymi wartosciami.
+	 */
+	Transakcja() = default;
+	/**
+	 * @brief  Ustala kwote transakcji.
 	 *
-	 * @return Wskaznik na znalezione konto lub nullptr jesli nie znaleziono
+	 * @param kwota Kwota transakcji
 	 */
-	KontoGlowne* znajdzKonto(const string& numerKonta)
+	void setKwota(Pieniadze kwota)
 	{
-		for (auto& konto : kontaUzytkownika)
-		{
-			if (konto->getNumerKonta() == numerKonta)
-			{
-				return konto;
-			}
+		if (kwota.czyUjemna()) {
+			cout << "Kwota transakcji nie moze byc ujemna." << endl;
+			return;
 		}
-		return nullptr; // Konto nie znalezione
+		this->kwota = kwota;
+	}
+	/**
+	 * @brief Ustala typ transakcji.
+	 *
+	 * @param typTransakcji Typ transakcji (np. Wpłata, wypłata, przelew)
+	 */
+	void setTypTransakcji(const string &typTransakcji)
+	{
+		if (typTransakcji == "wplata") this->typTransakcji = TypTransakcji::WPLATA;
+		else if (typTransakcji == "wyplata") this->typTransakcji = TypTransakcji::WYPLATA;
+		else if (typTransakcji == "przelew") this->typTransakcji = TypTransakcji::PRZELEW;
+		else if (typTransakcji == "odsetki") this->typTransakcji = TypTransakcji::ODSETKI;
+		else cout << "Niepoprawny typ transakcji." << endl;
+	}
+	/**
+	 * @brief Ustala typ transakcji.
+	 *
+	 * @param typ Typ transakcji
+	 */
+	void setTypTransakcji(TypTransakcji typ) { typTransakcji = typ; }
+	/**
+	 * @brief Ustala konto nadawcy.
+	 *
+	 * @param kontoNadawcy Numer konta nadawcy
+	 */
+	void setKontoNadawcy(const string &kontoNadawcy)
+	{
+		setIdNadawcy(SlownikNumerow::globalny().dodaj(kontoNadawcy));
+	}
+	/**
+	 * @brief Ustala konto odbiorcy.
+	 *
+	 * @param kontoOdbiorcy Numer konta odbiorcy
+	 */
+	void setKontoOdbiorcy(const string &kontoOdbiorcy)
+	{
+		setIdOdbiorcy(SlownikNumerow::globalny().dodaj(kontoOdbiorcy));
+	}
+	/**
+	 * @brief Ustala konto nadawcy przez identyfikator ze SlownikNumerow.
+	 *
+	 * @param id Identyfikator numeru konta nadawcy
+	 */
+	void setIdNadawcy(uint32_t id)
+	{
+		if (id == 0 && typTransakcji == TypTransakcji::PRZELEW)
+		{
+			throw Error("Niepoprawny numer konta nadawcy.");
+		}
+		kontoNadawcy = id;
+	}
+	/**
+	 * @brief Ustala konto odbiorcy przez identyfikator ze SlownikNumerow.
+	 *
+	 * @param id Identyfikator numeru konta odbiorcy
+	 */
+	void setIdOdbiorcy(uint32_t id)
+	{
+		if (id == 0 && typTransakcji == TypTransakcji::PRZELEW)
+		{
+			throw Error("Niepoprawny numer konta odbiorcy.");
+		}
+		kontoOdbiorcy = id;
+	}
+
+	void setDataTransakcji(const string& dataTransakcji)
+	{
+		uint32_t miesiac = Kalendarz::spakujMiesiac(dataTransakcji);
+		if (miesiac == 0)
+		{
+			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
+		}
+		miesiacTransakcji = miesiac;
+	}
+	/**
+	 * @brief Ustala date transakcji w postaci RRRRMM (np. z migawki binarnej).
+	 *
+	 * @param miesiac Data RRRRMM
+	 */
+	void setMiesiacTransakcji(uint32_t miesiac) { miesiacTransakcji = miesiac; }
+	/**
+	 * @brief Ustala moment wykonania transakcji.
+	 *
+	 * @param czas Sekundy od 1970 roku
+	 */
+	void setZnacznikCzasu(int64_t czas) { znacznikCzasu = czas; }
+	/**
+	 * @brief Zwraca kwote transakcji.
+	 *
+	 * @return Kwota transakcji
+	 */
+	Pieniadze getKwota() const { return kwota; }
+	/**
+	 * @brief Zwraca typ transakcji.
+	 *
+	 * @return Typ transakcji (np. Wpłata, wypłata, przelew)
+	 */
+	const string& getTypTransakcji() const { return nazwaTypu(typTransakcji); }
+	/**
+	 * @brief Zwraca typ transakcji jako wartosc wyliczeniowa.
+	 */
+	TypTransakcji getTyp() const { return typTransakcji; }
+	/**
+	 * @brief Zwraca date transakcji.
+	 *
+	 * @return Data transakcji w formacie MMRR
+	 */
+	string getDataTransakcji() const
+	{
+		if (miesiacTransakcji == 0) return string();
+		uint32_t miesiac = miesiacTransakcji % 100, rok = (miesiacTransakcji / 100) % 100;
+		string data = "0000";
+		data[0] = static_cast<char>('0' + miesiac / 10);
+		data[1] = static_cast<char>('0' + miesiac % 10);
+		data[2] = static_cast<char>('0' + rok / 10);
+		data[3] = static_cast<char>('0' + rok % 10);
+		return data;
+	}
+	/**
+	 * @brief Zwraca date transakcji jako liczbe RRRRMM.
+	 *
+	 * @return Data RRRRMM lub 0, jesli nieznana
+	 */
+	uint32_t getMiesiacTransakcji() const { return miesiacTransakcji; }
+	/**
+	 * @brief Zwraca moment wykonania transakcji.
+	 *
+	 * @return Sekundy od 1970 roku lub 0, jesli nieznany
+	 */
+	int64_t getZnacznikCzasu() const { return znacznikCzasu; }
+	/**
+	 * @brief Zwraca numer konta nadawcy.
+	 *
+	 * @return Numer konta nadawcy
+	 */
+	const string& getKontoNadawcy() const { return SlownikNumerow::globalny().numer(kontoNadawcy); }
+	/**
+	 * @brief Zwraca numer konta odbiorcy.
+	 *
+	 * @return Numer konta odbiorcy
+	 */
+	const string& getKontoOdbiorcy() const { return SlownikNumerow::globalny().numer(kontoOdbiorcy); }
+	/**
+	 * @brief Zwraca identyfikator numeru konta nadawcy w SlownikNumerow.
+	 */
+	uint32_t getIdNadawcy() const { return kontoNadawcy; }
+	/**
+	 * @brief Zwraca identyfikator numeru konta odbiorcy w SlownikNumerow.
+	 */
+	uint32_t getIdOdbiorcy() const { return kontoOdbiorcy; }
+	/**
+	 * @ brief Ustala szczegóły transakcji.
+	 *
+	 * Funckja ustala szczegóły transakcji, takie jak kwota, typ transakcji, data transakcji oraz numery kont nadawcy i odbiorcy.
+	 */
+	void szczegolyTransakcji()
+	{
+		cout << "Podaj kwote transakcji: ";
+		Pieniadze kwotaWpisana;
+		cin >> kwotaWpisana;
+		setKwota(kwotaWpisana);
+
+		cout << "Podaj typ transakcji (wplata/wypata/przelew): ";
+		string typTransakcjiWpisany;
+		cin >> typTransakcjiWpisany;
+		setTypTransakcji(typTransakcjiWpisany);
+
+		znacznikCzasu = static_cast<int64_t>(time(nullptr));
+		miesiacTransakcji = Kalendarz::globalny().getMiesiac();
+
+		if (typTransakcji == TypTransakcji::PRZELEW)
+		{
+			string numer;
+			cout << "Podaj numer konta nadawcy: ";
+			cin >> numer;
+			setKontoNadawcy(numer);
+			cout << "Podaj numer konta odbiorcy: ";
+			cin >> numer;
+			setKontoOdbiorcy(numer);
+		}
+	}
+	/**
+	 * @brief Wyświetla szczegóły transakcji.
+	 *
+	 * Funckja wyświetla szczegóły transakcji, takie jak kwota, typ transakcji, data transakcji oraz numery kont nadawcy i odbiorcy.
+	 */
+	void wyswietlSzczegolyTransakcji() const
+	{
+		cout << "===== SZCZEGOLY TRANSAKCJI =====" << endl;
+		cout << "Data transakcji: " << getDataTransakcji() << endl;
+		if (znacznikCzasu != 0)
+		{
+			time_t czas = static_cast<time_t>(znacznikCzasu);
+			tm chwila;
+			localtime_s(&chwila, &czas);
+			cout << "Czas transakcji: " << put_time(&chwila, "%d-%m-%Y %H:%M:%S") << endl;
+		}
+		cout << "Typ transakcji: " << getTypTransakcji() << endl;
+		cout << "Kwota: " << fixed << setprecision(2) << getKwota() << " PLN" << endl;
+		if (typTransakcji == TypTransakcji::PRZELEW)
+		{
+			cout << "Konto nadawcy: " << getKontoNadawcy() << endl;
+			cout << "Konto odbiorcy: " << getKontoOdbiorcy() << endl;
+		}
+		else if (typTransakcji == TypTransakcji::ODSETKI || typTransakcji == TypTransakcji::WPLATA)
+		{
+			cout << "Konto odbiorcy: " << getKontoOdbiorcy() << endl;
+		}
+		cout << "===============================" << endl;
+	}
+};
+
+static_assert(sizeof(Transakcja) == 32, "Transakcja powinna zajmowac 32 bajty");
+
+/**
+ * @class KartaDebetowa
+ * @brief Reprezentuje karte debetowa.
+ * @extends Karta
+ *
+ * Implementacja konkretnego typu karty - karty debetowej,
+ * która jest powiązana z kontem bankowym i posiada dzienny limit transakcji.
+ */
+class KartaDebetowa : public Karta {
+private:
+	uint32_t powiazaneKonto; ///< Identyfikator powiązanego konta w SlownikNumerow
+	Pieniadze dziennyLimit; ///< Dzienny limit transakcji (ustawiony, nie zmniejszany przez platnosci)
+	/// (RRRRMMDD << BITY_KWOTY) | suma platnosci z tego dnia w groszach; inny dzien oznacza licznik rowny 0.
+	/// Jedno slowo, zeby sprawdzenie limitu i zaksiegowanie platnosci byly jednym CAS
+	atomic<uint64_t> wydatki{ 0 };
+
+	static const unsigned BITY_KWOTY = 37; ///< Do ok. 1,37 mld zl dziennie; dzien RRRRMMDD miesci sie w pozostalych 27 bitach
+	static const uint64_t MASKA_KWOTY = (uint64_t(1) << BITY_KWOTY) - 1;
+
+	static uint64_t spakujWydatki(uint32_t dzien, int64_t grosze)
+	{
+		return (static_cast<uint64_t>(dzien) << BITY_KWOTY) | static_cast<uint64_t>(grosze);
+	}
+	static uint32_t dzienZ(uint64_t spakowane) { return static_cast<uint32_t>(spakowane >> BITY_KWOTY); }
+	static int64_t kwotaZ(uint64_t spakowane) { return static_cast<int64_t>(spakowane & MASKA_KWOTY); }
+public:
+	/**
+	 * @brief Konstruktor klasy KartaDebetowa.
+	 *
+	 * Inicjalizuje obiekt KartaDebetowa z podanymi parametrami.
+	 *
+	 * @param numer Numer karty
+	 * @param data Data waznosci karty
+	 * @param kod Kod CVC karty
+	 * @param powiazaneKonto Powiązane konto bankowe
+	 * @param limit Dzienny limit transakcji
+	 */
+	KartaDebetowa(string numer, string data, string kod, string powiazaneKonto, Pieniadze limit)
+		: Karta(numer, data, kod), powiazaneKonto(SlownikNumerow::globalny().dodaj(powiazaneKonto)), dziennyLimit(limit) {}
+
+	/**
+	 * @brief Zwraca typ karty
+	 * @return Typ karty
+	 *
+	 * Implementacja metody czysto wirtualnej z klasy bazowej Karta.
+	 */
+	string getTypKarty() const override { return "Debetowa"; }
+	/**
+	 * @brief Pobiera numer powiązanego konta.
+	 * @return Identyfikator konta
+	 */
+	const string& getPowiazaneKonto() const { return SlownikNumerow::globalny().numer(powiazaneKonto); }
+	/**
+	 * @brief Pobiera identyfikator powiązanego konta w SlownikNumerow.
+	 * @return Identyfikator konta
+	 */
+	uint32_t getIdPowiazanegoKonta() const { return powiazaneKonto; }
+	/**
+	 * @brief  Pobiera dzienny limit transakcji
+	 * @return Wartość dziennego limitu
+	 */
+	Pieniadze getDziennyLimit() const { return dziennyLimit; }
+	/**
+	 * @brief Pobiera sume platnosci z biezacego dnia
+	 * @return Kwota wydana dzisiaj (0, jesli licznik dotyczy innego dnia)
+	 */
+	Pieniadze getWydaneDzisiaj() const
+	{
+		const uint64_t biezace = wydatki.load(memory_order_relaxed);
+		return Pieniadze::zGroszy(dzienZ(biezace) == Kalendarz::globalny().getDzien() ? kwotaZ(biezace) : 0);
+	}
+	/**
+	 * @brief Pobiera licznik wydatkow razem z dniem, ktorego dotyczy (do zapisu)
+	 * @return Dzien RRRRMMDD licznika
+	 */
+	uint32_t getDzienWydatkow() const { return dzienZ(wydatki.load(memory_order_relaxed)); }
+	/**
+	 * @brief Pobiera zapisana sume platnosci z dnia getDzienWydatkow
+	 * @return Kwota licznika bez sprawdzania dnia
+	 */
+	Pieniadze getLicznikWydatkow() const { return Pieniadze::zGroszy(kwotaZ(wydatki.load(memory_order_relaxed))); }
+	/**
+	 * @brief Ustawia licznik wydatkow (np. przy wczytywaniu danych)
+	 * @param wydane Suma platnosci (ujemna lub za duza jest obcinana do zakresu licznika)
+	 * @param dzien Dzien RRRRMMDD, ktorego dotyczy suma
+	 */
+	void setWydaneDzisiaj(Pieniadze wydane, uint32_t dzien)
+	{
+		const int64_t grosze = min<int64_t>(max<int64_t>(wydane.getGrosze(), 0), static_cast<int64_t>(MASKA_KWOTY));
+		wydatki.store(spakujWydatki(dzien, grosze), memory_order_relaxed);
+		oznaczZmiane();
+	}
+	/**
+	 * @brief Dolicza platnosc do licznika wydatkow, jesli miesci sie w pozostalym dziennym limicie.
+	 *
+	 * Sprawdzenie limitu i zaksiegowanie sa jednym CAS, wiec rownolegle autoryzacje jedna
+	 * karta nie przekrocza limitu. Licznik z poprzedniego dnia liczy sie jako 0.
+	 *
+	 * @param kwota Kwota platnosci (dodatnia)
+	 * @param dzien Biezacy dzien RRRRMMDD
+	 * @return false jesli platnosc przekroczylaby dzienny limit
+	 */
+	bool rezerwujWydatek(Pieniadze kwota, uint32_t dzien)
+	{
+		const int64_t limit = dziennyLimit.getGrosze();
+		uint64_t biezace = wydatki.load(memory_order_relaxed);
+		int64_t wydane;
+		do
+		{
+			wydane = dzienZ(biezace) == dzien ? kwotaZ(biezace) : 0;
+			if (kwota.getGrosze() > limit - wydane || wydane + kwota.getGrosze() > static_cast<int64_t>(MASKA_KWOTY)) return false;
+		} while (!wydatki.compare_exchange_weak(biezace, spakujWydatki(dzien, wydane + kwota.getGrosze()), memory_order_relaxed));
+		oznaczZmiane();
+		return true;
+	}
+	/**
+	 * @brief Oddaje kwote zarezerwowana przez rezerwujWydatek, gdy obciazenie konta sie nie udalo.
+	 *
+	 * @param kwota Zarezerwowana kwota
+	 * @param dzien Dzien, w ktorym kwota zostala zarezerwowana
+	 */
+	void zwolnijWydatek(Pieniadze kwota, uint32_t dzien)
+	{
+		uint64_t biezace = wydatki.load(memory_order_relaxed);
+		do
+		{
+			if (dzienZ(biezace) != dzien || kwotaZ(biezace) < kwota.getGrosze()) return;
+		} while (!wydatki.compare_exchange_weak(biezace, biezace - static_cast<uint64_t>(kwota.getGrosze()), memory_order_relaxed));
+	}
+	/**
+	 * @brief Ustawia numer powiązanego konta
+	 * @param konto Nowy identyfikator konta
+	 */
+	void setPowiazaneKonto(string konto) { powiazaneKonto = SlownikNumerow::globalny().dodaj(konto); oznaczZmiane(); }
+	/**
+	 * @brief Ustawia powiązane konto przez identyfikator ze SlownikNumerow
+	 * @param id Identyfikator konta
+	 */
+	void setIdPowiazanegoKonta(uint32_t id) { powiazaneKonto = id; oznaczZmiane(); }
+	/**
+	 * @brief Ustawia dzienny limit transakcji
+	 * @param limit Nowa wartość dziennego limitu
+	 */
+	void setDziennyLimit(Pieniadze limit)
+	{
+		if (limit.czyUjemna())
+		{
+			throw Error("Dzienny limit nie moze byc ujemny.");
+		}
+		dziennyLimit = limit;
+		oznaczZmiane();
+	}
+	/**
+	 * @brief Wykonuje płatność kartą
+	 * @param kwota Kwota transakcji
+	 * @return true jeśli płatność została wykonana pomyślnie, false w przeciwnym razie
+	 *
+	 * Metoda weryfikuje czy żądana kwota nie przekracza dziennego limitu transakcji
+	 * i czy karta jest ważna, a następnie wykonuje płatność.
+	 * Licznik wydatkow jest zerowany przy pierwszej platnosci w nowym dniu, wiec nie jest
+	 * potrzebne nocne zerowanie wszystkich kart.
+	 */
+	bool wykonajPlatnosc(Pieniadze kwota)
+	{
+		if (!kwota.czyDodatnia())
+		{
+			cerr << "Kwota transakcji musi byc wieksza od zera." << endl;
+			return false;
+		}
+
+		if (!czyWazna())
+		{
+			cerr << "Karta jest niewazna." << endl;
+			return false;
+
+		}
+		if (!rezerwujWydatek(kwota, Kalendarz::globalny().getDzien()))
+		{
+			cerr << "Kwota transakcji przekracza dzienny limit." << endl;
+			return false;
+		}
+
+		cout << "Platnosc zakonczona sukcesem. Pozostaly limit: " << dziennyLimit - getWydaneDzisiaj() << " PLN" << endl;
+		return true;
+	}
+};
+/// Wynik autoryzacji platnosci karta
+enum class WynikAutoryzacji : uint8_t
+{
+	ZAAKCEPTOWANA = 0,
+	NIEZNANA_KARTA,
+	NIEPOPRAWNA_KWOTA,
+	KARTA_NIEWAZNA,
+	NIEPOPRAWNY_PIN,
+	PRZEKROCZONY_LIMIT,
+	BRAK_KONTA,
+	BRAK_SRODKOW
+};
+
+/**
+ * @class AutoryzacjaKart
+ * @brief Autoryzuje platnosci kartami debetowymi po numerze karty.
+ *
+ * Karty sa wyszukiwane po numerze zamienionym na liczbe w tablicy mieszajacej z adresowaniem
+ * otwartym (klucz i wskaznik leza obok siebie, wiec wyszukanie to zwykle jeden odczyt z pamieci),
+ * a autoryzacja nie przeglada listy kart i nie przydziela pamieci. Sprawdzane sa kwota,
+ * waznosc karty, PIN, dzienny limit i saldo powiazanego konta; wynik jest zwracany jako
+ * kod, bez wypisywania komunikatow. Zaakceptowana platnosc obciaza konto i licznik wydatkow
+ * karty - utrwalenie zmian nalezy do wywolujacego.
+ */
+class AutoryzacjaKart
+{
+private:
+	static const uint64_t PUSTE = 0; ///< Klucz wolnego miejsca
+	static const uint64_t USUNIETE = 1; ///< Klucz miejsca po usunietej karcie (zaden numer nie ma klucza 1)
+
+	/// Miejsce w tablicy mieszajacej
+	struct Miejsce
+	{
+		uint64_t klucz;
+		KartaDebetowa* karta;
+	};
+
+	vector<Miejsce> miejsca; ///< Tablica o rozmiarze potegi dwojki, zapelniona najwyzej w polowie
+	size_t zajete = 0; ///< Liczba miejsc z kartami lub po usunietych kartach
+	const vector<KontoGlowne*>& kontaPoId; ///< Katalog kont wedlug identyfikatora numeru
+
+	/**
+	 * @brief Zwraca pierwsze miejsce do sprawdzenia dla klucza.
+	 */
+	size_t poczatek(uint64_t klucz) const
+	{
+		return static_cast<size_t>((klucz * 0x9E3779B97F4A7C15ull) >> 32) & (miejsca.size() - 1);
+	}
+	/**
+	 * @brief Zmienia rozmiar tablicy i wstawia karty od nowa, pomijajac usuniete.
+	 */
+	void przebuduj(size_t rozmiar)
+	{
+		vector<Miejsce> stare(rozmiar, Miejsce{ PUSTE, nullptr });
+		stare.swap(miejsca);
+		zajete = 0;
+		for (const Miejsce& m : stare)
+		{
+			if (m.klucz > USUNIETE) wstaw(m.klucz, m.karta);
+		}
+	}
+	/**
+	 * @brief Wstawia karte; wymaga wolnego miejsca w tablicy.
+	 *
+	 * @return false jesli karta o tym numerze juz jest w indeksie (zostaje pierwsza karta)
+	 */
+	bool wstaw(uint64_t klucz, KartaDebetowa* karta)
+	{
+		for (size_t i = poczatek(klucz); ; i = (i + 1) & (miejsca.size() - 1))
+		{
+			if (miejsca[i].klucz == klucz) return false;
+			if (miejsca[i].klucz == PUSTE)
+			{
+				miejsca[i] = Miejsce{ klucz, karta };
+				zajete++;
+				return true;
+			}
+		}
+	}
+
+public:
+	/**
+	 * @param kontaPoId Katalog kont, w ktorym wyszukiwane sa konta powiazane z kartami
+	 */
+	explicit AutoryzacjaKart(const vector<KontoGlowne*>& kontaPoId) : kontaPoId(kontaPoId) {}
+
+	/**
+	 * @brief Zamienia numer karty na klucz indeksu.
+	 *
+	 * Klucz to liczba z cyframi numeru poprzedzonymi cyfra 1, wiec zera wiodace sa zachowane.
+	 *
+	 * @param numer Numer karty (do 18 cyfr)
+	 * @return Klucz lub 0, jesli numer nie jest poprawny
+	 */
+	static uint64_t kluczKarty(const string& numer)
+	{
+		if (numer.empty() || numer.length() > 18) return 0;
+		uint64_t klucz = 1;
+		for (char c : numer)
+		{
+			unsigned cyfra = static_cast<unsigned>(c - '0');
+			if (cyfra > 9) return 0;
+			klucz = klucz * 10 + cyfra;
+		}
+		return klucz;
+	}
+	/**
+	 * @brief Zwraca opis wyniku autoryzacji do wyswietlenia.
+	 */
+	static const char* opisWyniku(WynikAutoryzacji wynik)
+	{
+		switch (wynik)
+		{
+		case WynikAutoryzacji::ZAAKCEPTOWANA: return "Platnosc zaakceptowana";
+		case WynikAutoryzacji::NIEZNANA_KARTA: return "Nieznana karta";
+		case WynikAutoryzacji::NIEPOPRAWNA_KWOTA: return "Kwota transakcji musi byc wieksza od zera";
+		case WynikAutoryzacji::KARTA_NIEWAZNA: return "Karta jest niewazna";
+		case WynikAutoryzacji::NIEPOPRAWNY_PIN: return "Niepoprawny PIN";
+		case WynikAutoryzacji::PRZEKROCZONY_LIMIT: return "Kwota transakcji przekracza dzienny limit";
+		case WynikAutoryzacji::BRAK_KONTA: return "Brak konta powiazanego z karta";
+		case WynikAutoryzacji::BRAK_SRODKOW: return "Niewystarczajace srodki lub wyczerpany limit wyplat konta";
+		}
+		return "";
+	}
+
+	/**
+	 * @brief Rezerwuje miejsce w indeksie na podana liczbe kart.
+	 */
+	void rezerwuj(size_t liczba)
+	{
+		size_t rozmiar = 16;
+		while (rozmiar < 2 * (zajete + liczba)) rozmiar *= 2;
+		if (rozmiar > miejsca.size()) przebuduj(rozmiar);
+	}
+	/**
+	 * @brief Dodaje karte do indeksu. Przy powtorzonym numerze zostaje pierwsza karta.
+	 *
+	 * @return false jesli numer jest niepoprawny lub karta o tym numerze juz jest w indeksie
+	 */
+	bool dodaj(KartaDebetowa* karta)
+	{
+		uint64_t klucz = kluczKarty(karta->getNumerKarty());
+		if (klucz == 0) return false;
+		if (2 * (zajete + 1) > miejsca.size()) przebuduj(max<size_t>(16, 2 * miejsca.size()));
+		return wstaw(klucz, karta);
+	}
+	/**
+	 * @brief Usuwa karte z indeksu (przed jej usunieciem z pamieci).
+	 */
+	void usun(const Karta* karta)
+	{
+		uint64_t klucz = kluczKarty(karta->getNumerKarty());
+		if (klucz == 0 || miejsca.empty()) return;
+		for (size_t i = poczatek(klucz); miejsca[i].klucz != PUSTE; i = (i + 1) & (miejsca.size() - 1))
+		{
+			if (miejsca[i].klucz == klucz)
+			{
+				if (miejsca[i].karta == karta) miejsca[i] = Miejsce{ USUNIETE, nullptr };
+				return;
+			}
+		}
+	}
+	/**
+	 * @brief Wyszukuje karte po numerze.
+	 *
+	 * @return Karta lub nullptr
+	 */
+	KartaDebetowa* znajdz(const string& numerKarty) const
+	{
+		uint64_t klucz = kluczKarty(numerKarty);
+		if (klucz == 0 || miejsca.empty()) return nullptr;
+		for (size_t i = poczatek(klucz); miejsca[i].klucz != PUSTE; i = (i + 1) & (miejsca.size() - 1))
+		{
+			if (miejsca[i].klucz == klucz) return miejsca[i].karta;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Autoryzuje platnosc karta i przy akceptacji obciaza powiazane konto.
+	 *
+	 * @param numerKarty Numer karty
+	 * @param pin PIN podany przy platnosci
+	 * @param kwota Kwota platnosci
+	 * @param obciazonaKarta Jesli podany, przy akceptacji dostaje wskaznik karty (bez ponownego wyszukiwania)
+	 * @return Wynik autoryzacji
+	 */
+	WynikAutoryzacji autoryzuj(const string& numerKarty, const string& pin, Pieniadze kwota, KartaDebetowa** obciazonaKarta = nullptr)
+	{
+		KartaDebetowa* karta = znajdz(numerKarty);
+		if (karta == nullptr) return WynikAutoryzacji::NIEZNANA_KARTA;
+		if (!kwota.czyDodatnia()) return WynikAutoryzacji::NIEPOPRAWNA_KWOTA;
+		if (!karta->czyWazna()) return WynikAutoryzacji::KARTA_NIEWAZNA;
+		if (!karta->czyPoprawnyPin(pin)) return WynikAutoryzacji::NIEPOPRAWNY_PIN;
+
+		const uint32_t idKonta = karta->getIdPowiazanegoKonta();
+		KontoGlowne* konto = idKonta < kontaPoId.size() ? kontaPoId[idKonta] : nullptr;
+		if (konto == nullptr) return WynikAutoryzacji::BRAK_KONTA;
+
+		const uint32_t dzien = Kalendarz::globalny().getDzien();
+		if (!karta->rezerwujWydatek(kwota, dzien)) return WynikAutoryzacji::PRZEKROCZONY_LIMIT;
+		if (!konto->obciaz(kwota))
+		{
+			karta->zwolnijWydatek(kwota, dzien);
+			return WynikAutoryzacji::BRAK_SRODKOW;
+		}
+
+		if (obciazonaKarta != nullptr) *obciazonaKarta = karta;
+		return WynikAutoryzacji::ZAAKCEPTOWANA;
+	}
+};
+
+/// Wynik przelewu wykonanego przez SilnikPrzelewow
+enum class WynikPrzelewu : uint8_t
+{
+	WYKONANY = 0,
+	NIEPOPRAWNA_KWOTA,
+	TO_SAMO_KONTO,
+	BRAK_KONTA,
+	ODRZUCONY ///< Brak srodkow lub wyczerpany limit wyplat konta oszczednosciowego
+};
+
+/**
+ * @struct ZleceniePrzelewu
+ * @brief Przelew miedzy kontami banku wskazanymi identyfikatorami numerow.
+ */
+struct ZleceniePrzelewu
+{
+	uint32_t nadawca; ///< Identyfikator numeru konta nadawcy w SlownikNumerow
+	uint32_t odbiorca; ///< Identyfikator numeru konta odbiorcy w SlownikNumerow
+	Pieniadze kwota;
+};
+
+/**
+ * @class SilnikPrzelewow
+ * @brief Wykonuje przelewy miedzy kontami banku z wielu watkow jednoczesnie.
+ *
+ * Kazde konto jest chronione jedna z LICZBA_BLOKAD blokad wybrana po identyfikatorze konta
+ * (podzial blokad), wiec przelewy miedzy roznymi kontami zwykle nie czekaja na siebie, a pamiec
+ * blokad nie rosnie z liczba kont. Przelew zajmuje blokady nadawcy i odbiorcy zawsze w kolejnosci
+ * rosnacych numerow blokad, wiec dwa przelewy w przeciwnych kierunkach nie moga sie zakleszczyc.
+ *
+ * Salda i licznik wyplat kont oszczednosciowych sa atomowe, wiec pojedyncze wplaty i uznania
+ * moga odbywac sie obok silnika bez blokad; blokady sprawiaja, ze obciazenie i uznanie przelewu
+ * sa widoczne dla innych przelewow razem. Podczas pracy silnika katalog kont nie moze byc
+ * zmieniany (konta nie sa dodawane ani usuwane).
+ */
+class SilnikPrzelewow
+{
+private:
+	static const uint32_t LICZBA_BLOKAD = 4096; ///< Potega dwojki
+
+	/// Blokada wyrownana do linii pamieci podrecznej, zeby sasiednie blokady jej nie dzielily
+	struct alignas(64) Blokada
+	{
+		mutex m;
+	};
+
+	// new w C++14 nie gwarantuje wyrownania wiekszego niz alignof(max_align_t),
+	// wiec tablica blokad jest umieszczana w pamieci z zapasem na wyrownanie
+	unique_ptr<char[]> pamiecBlokad;
+	Blokada* blokady;
+	const vector<KontoGlowne*>& kontaPoId; ///< Katalog kont wedlug identyfikatora numeru
+
+	static uint32_t numerBlokady(uint32_t idKonta) { return idKonta & (LICZBA_BLOKAD - 1); }
+
+public:
+	/**
+	 * @param kontaPoId Katalog kont, w ktorym wyszukiwane sa konta nadawcy i odbiorcy
+	 */
+	explicit SilnikPrzelewow(const vector<KontoGlowne*>& kontaPoId) : kontaPoId(kontaPoId)
+	{
+		size_t rozmiar = sizeof(Blokada) * LICZBA_BLOKAD + alignof(Blokada) - 1;
+		pamiecBlokad.reset(new char[rozmiar]);
+		void* poczatek = pamiecBlokad.get();
+		blokady = static_cast<Blokada*>(align(alignof(Blokada), sizeof(Blokada) * LICZBA_BLOKAD, poczatek, rozmiar));
+		for (uint32_t i = 0; i < LICZBA_BLOKAD; i++) new (&blokady[i]) Blokada();
+	}
+	~SilnikPrzelewow()
+	{
+		for (uint32_t i = 0; i < LICZBA_BLOKAD; i++) blokady[i].~Blokada();
+	}
+
+	/**
+	 * @brief Zwraca opis wyniku przelewu do wyswietlenia.
+	 */
+	static const char* opisWyniku(WynikPrzelewu wynik)
+	{
+		switch (wynik)
+		{
+		case WynikPrzelewu::WYKONANY: return "Przelew wykonany";
+		case WynikPrzelewu::NIEPOPRAWNA_KWOTA: return "Kwota przelewu musi byc wieksza od zera";
+		case WynikPrzelewu::TO_SAMO_KONTO: return "Nadawca i odbiorca to to samo konto";
+		case WynikPrzelewu::BRAK_KONTA: return "Konto nadawcy lub odbiorcy nie istnieje";
+		case WynikPrzelewu::ODRZUCONY: return "Niewystarczajace srodki lub wyczerpany limit wyplat konta";
+		}
+		return "";
+	}
+
+	/**
+	 * @brief Przenosi kwote z konta nadawcy na konto odbiorcy; mozna wywolywac z wielu watkow.
+	 *
+	 * @param zlecenie Nadawca, odbiorca i kwota przelewu
+	 * @return Wynik przelewu
+	 */
+	WynikPrzelewu przelej(const ZleceniePrzelewu& zlecenie)
+	{
+		if (!zlecenie.kwota.czyDodatnia()) return WynikPrzelewu::NIEPOPRAWNA_KWOTA;
+		if (zlecenie.nadawca == zlecenie.odbiorca) return WynikPrzelewu::TO_SAMO_KONTO;
+		KontoGlowne* nadawca = zlecenie.nadawca < kontaPoId.size() ? kontaPoId[zlecenie.nadawca] : nullptr;
+		KontoGlowne* odbiorca = zlecenie.odbiorca < kontaPoId.size() ? kontaPoId[zlecenie.odbiorca] : nullptr;
+		if (nadawca == nullptr || odbiorca == nullptr) return WynikPrzelewu::BRAK_KONTA;
+
+		const uint32_t a = numerBlokady(zlecenie.nadawca);
+		const uint32_t b = numerBlokady(zlecenie.odbiorca);
+		unique_lock<mutex> pierwsza(blokady[min(a, b)].m);
+		unique_lock<mutex> druga;
+		if (a != b) druga = unique_lock<mutex>(blokady[max(a, b)].m);
+
+		if (!nadawca->obciaz(zlecenie.kwota)) return WynikPrzelewu::ODRZUCONY;
+		odbiorca->uznaj(zlecenie.kwota);
+		return WynikPrzelewu::WYKONANY;
+	}
+};
+
+/**
+ * @class KontoOszczednosciowe
+ * @brief Reprezentuje konto oszczędnościowe.
+ *
+ * Klasa dziedziczy po klasie Konto i dodaje funkcjonalności specyficzne dla kont oszczędnościowych.
+ */
+class KontoOszczednosciowe : public KontoGlowne {
+	// Oprocentowanie, miesiac ostatniej kapitalizacji (RRRRMM), ograniczenie liczby wyplat
+	// w miesiacu i liczba wykonanych wyplat leza w kolumnach MagazynKont
+
+	/**
+	 * @brief Laczy miesiac i licznik wyplat w jedno slowo kolumny wyplaty.
+	 */
+	static uint64_t spakujWyplaty(uint32_t miesiac, int liczba)
+	{
+		return (static_cast<uint64_t>(miesiac) << 32) | static_cast<uint32_t>(liczba);
+	}
+	/**
+	 * @brief Rezerwuje jedna wyplate z miesiecznego limitu.
+	 *
+	 * Sprawdzenie limitu i zwiekszenie licznika sa jednym CAS, wiec rownolegle wyplaty
+	 * z jednego konta nie przekrocza limitu. Licznik z poprzedniego miesiaca liczy sie jako 0.
+	 *
+	 * @param miesiac Biezacy miesiac RRRRMM
+	 * @return false jesli limit wyplat jest wyczerpany
+	 */
+	bool rezerwujWyplate(uint32_t miesiac)
+	{
+		atomic<uint64_t>& wyplaty = kolumny().wyplaty[pozycja()];
+		const int limit = getOgraniczenieWyplat();
+		uint64_t biezace = wyplaty.load(memory_order_relaxed);
+		int wykonane;
+		do
+		{
+			wykonane = static_cast<uint32_t>(biezace >> 32) == miesiac ? static_cast<int>(biezace & 0xFFFFFFFFu) : 0;
+			if (wykonane >= limit) return false;
+		} while (!wyplaty.compare_exchange_weak(biezace, spakujWyplaty(miesiac, wykonane + 1), memory_order_relaxed));
+		return true;
+	}
+	/**
+	 * @brief Oddaje wyplate zarezerwowana przez rezerwujWyplate, gdy obciazenie sie nie udalo.
+	 *
+	 * @param miesiac Miesiac, w ktorym wyplata zostala zarezerwowana
+	 */
+	void zwolnijWyplate(uint32_t miesiac)
+	{
+		atomic<uint64_t>& wyplaty = kolumny().wyplaty[pozycja()];
+		uint64_t biezace = wyplaty.load(memory_order_relaxed);
+		do
+		{
+			if (static_cast<uint32_t>(biezace >> 32) != miesiac || (biezace & 0xFFFFFFFFu) == 0) return;
+		} while (!wyplaty.compare_exchange_weak(biezace, biezace - 1, memory_order_relaxed));
+	}
+public:
+	/**
+	 * @brief Konstruktor klasy KontoOszczednosciowe.
+	 *
+	 * Inicjalizuje obiekt KontoOszczednosciowe z podanymi parametrami.
+	 *
+	 * @param numer Numer konta
+	 * @param saldo Saldo konta
+	 * @param oprocentowanie Oprocentowanie konta oszczędnościowego
+	 * @param dataKapitalizacji Data ostatniej kapitalizacji odsetek
+	 * @param limitWyplat Ograniczenie liczby wypłat w miesiącu
+	 */
+	KontoOszczednosciowe(string numer, Pieniadze saldo, float oprocentowanie, string dataKapitalizacji, int limitWyplat)
+		: KontoGlowne(numer, "Oszczednosciowe", saldo)
+	{
+		kolumny().rodzaj[pozycja()] = MagazynKont::OSZCZEDNOSCIOWE;
+		kolumny().oprocentowanie[pozycja()] = oprocentowanie;
+		kolumny().miesiacKapitalizacji[pozycja()] = Kalendarz::spakujMiesiac(dataKapitalizacji); // 0 - nie bedzie kapitalizowane
+		kolumny().limitWyplat[pozycja()] = limitWyplat;
+	}
+
+	/**
+	 * @brief Zwraca oprocentowanie konta oszczędnościowego.
+	 *
+	 * @return Oprocentowanie konta oszczędnościowego
+	 */
+	float getOprocentowanie() const { return kolumny().oprocentowanie[pozycja()]; }
+	/**
+	 * @brief Zwraca datę ostatniej kapitalizacji odsetek.
+	 *
+	 * @return Data ostatniej kapitalizacji odsetek
+	 */
+	string getDataOstatniejKapitalizacji() const
+	{
+		return Kalendarz::formatujMiesiac(getMiesiacKapitalizacji());
+	}
+	/**
+	 * @brief Zwraca miesiac ostatniej kapitalizacji jako liczbe RRRRMM.
+	 *
+	 * @return Miesiac RRRRMM lub 0, jesli data jest niepoprawna
+	 */
+	uint32_t getMiesiacKapitalizacji() const { return kolumny().miesiacKapitalizacji[pozycja()]; }
+
+	/**
+	* @brief Zwraca ograniczenie liczby wypłat w miesiącu.
+	*
+	* @return Ograniczenie liczby wypłat w miesiącu
+	*/
+	int getOgraniczenieWyplat() const { return kolumny().limitWyplat[pozycja()]; }
+
+	/**
+	* @brief Zwraca liczbę wykonanych wypłat w danym miesiącu.
+	*
+	* Licznik z wcześniejszego miesiąca oznacza, że w bieżącym nie było jeszcze wypłat.
+	*
+	* @return Liczba wykonanych wypłat w danym miesiącu
+	*/
+	int getWykonaneWyplatywWMiesiacu() const
+	{
+		return getMiesiacWyplat() == Kalendarz::globalny().getMiesiac() ? getLicznikWyplat() : 0;
+	}
+	/**
+	* @brief Zwraca zapisany licznik wypłat bez sprawdzania miesiąca (do zapisu).
+	*
+	* @return Liczba wypłat w miesiącu getMiesiacWyplat
+	*/
+	int getLicznikWyplat() const { return static_cast<int>(kolumny().wyplaty[pozycja()].load(memory_order_relaxed) & 0xFFFFFFFFu); }
+	/**
+	* @brief Zwraca miesiąc, którego dotyczy licznik wypłat.
+	*
+	* @return Miesiąc RRRRMM (0 - brak wypłat)
+	*/
+	uint32_t getMiesiacWyplat() const { return static_cast<uint32_t>(kolumny().wyplaty[pozycja()].load(memory_order_relaxed) >> 32); }
+	/**
+	 * @brief Ustala oprocentowanie konta oszczędnościowego.
+	 *
+	 * @param oprocentowanie Oprocentowanie konta oszczędnościowego
+	 */
+	void setOprocentowanie(float oprocentowanie)
+	{
+		if (oprocentowanie < 0) {
+			cout << "Oprocentowanie nie moze byc ujemne." << endl;
+			return;
+		}
+		kolumny().oprocentowanie[pozycja()] = oprocentowanie;
+		oznaczZmiane();
+	}
+	/**
+	 * @brief Ustala datę ostatniej kapitalizacji odsetek.
+	 *
+	 * @param dataKapitalizacji Data ostatniej kapitalizacji odsetek
+	 */
+	void setDataOstatniejKapitalizacji(string data)
+	{
+		uint32_t miesiac = Kalendarz::spakujMiesiac(data);
+		if (miesiac == 0)
+		{
+			throw Error("Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY");
+		}
+		kolumny().miesiacKapitalizacji[pozycja()] = miesiac;
+		oznaczZmiane();
+	}
+	/**
+	 * @brief Ustala miesiac ostatniej kapitalizacji w postaci RRRRMM (np. z migawki binarnej).
+	 *
+	 * @param miesiac Miesiac RRRRMM
+	 */
+	void setMiesiacKapitalizacji(uint32_t miesiac) { kolumny().miesiacKapitalizacji[pozycja()] = miesiac; oznaczZmiane(); }
+	/**
+	 * @brief Ustala ograniczenie liczby wypłat w miesiącu.
+	 *
+	 * @param limitWyplat Ograniczenie liczby wypłat w miesiącu
+	 */
+	void setOgraniczenieWyplat(int limitWyplat)
+	{
+		if (limitWyplat < 0) {
+			cout << "Ograniczenie wypłat nie może być ujemne." << endl;
+			return;
+		}
+		kolumny().limitWyplat[pozycja()] = limitWyplat;
+		oznaczZmiane();
+	}
+
+	/**
+	 * @brief Ustala licznik wypłat (np. przy wczytywaniu danych).
+	 *
+	 * @param liczba Liczba wypłat
+	 * @param miesiac Miesiąc RRRRMM, którego dotyczy licznik
+	 */
+	void setWykonaneWyplaty(int liczba, uint32_t miesiac)
+	{
+		kolumny().wyplaty[pozycja()].store(spakujWyplaty(miesiac, liczba), memory_order_relaxed);
+		oznaczZmiane();
+	}
+
+	/**
+	 * @brief Wplaca pieniadze na konto oszczędnościowe.
+	 *
+	 * @param kwota Kwota do wplaty
+	 * @return true jeśli wplata powiodła się, false w przeciwnym razie
+	 */
+	bool wplac(Pieniadze kwota) override
+	{
+		return KontoGlowne::wplac(kwota);
+	}
+	/**
+	 * @brief Wyplaca pieniadze z konta oszczędnościowego.
+	 *
+	 * Licznik wyplat z poprzedniego miesiaca jest zerowany przy pierwszej wyplacie
+	 * w nowym miesiacu, wiec poczatek miesiaca nie wymaga przegladania wszystkich kont.
+	 *
+	 * @param kwota Kwota do wyplaty
+	 * @return true jeśli wyplata powiodła się, false w przeciwnym razie
+	 */
+	bool wyplac(Pieniadze kwota) override
+	{
+		const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+		if (!rezerwujWyplate(miesiac))
+		{
+			cout << "Przekroczono limit wyplat w tym miesiacu (" << getOgraniczenieWyplat() << ")." << endl;
+			return false;
+		}
+
+		bool wyplataUdana = KontoGlowne::wyplac(kwota);
+
+		if (wyplataUdana)
+		{
+			cout << "Dostepna liczba wyplat w tym, miesiacu: " << getOgraniczenieWyplat() - getWykonaneWyplatywWMiesiacu() << endl;
+		}
+		else
+		{
+			zwolnijWyplate(miesiac);
+		}
+		return wyplataUdana;
+	}
+	/**
+	 * @brief Obciaza konto bez komunikatow; obciazenie liczy sie jako wyplata w miesiacu.
+	 *
+	 * Wyplata jest najpierw rezerwowana w limicie, a oddawana, jesli brakuje srodkow,
+	 * wiec rownolegle obciazenia jednego konta nie przekrocza limitu ani nie zgubia wyplaty.
+	 *
+	 * @param kwota Kwota dodatnia
+	 * @return false jesli saldo jest niewystarczajace lub limit wyplat jest wyczerpany
+	 */
+	bool obciaz(Pieniadze kwota) override
+	{
+		const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+		if (!rezerwujWyplate(miesiac)) return false;
+		if (KontoGlowne::obciaz(kwota)) return true;
+		zwolnijWyplate(miesiac);
+		return false;
+	}
+
+	void wyswietlInformacje() const override
+	{
+		cout << "===== DANE KONTA OSZCZEDNOSCIOWEGO =====" << endl;
+		cout << "Typ konta: " << getTypKonta() << endl;
+		cout << "Numer konta: " << getNumerKonta() << endl;
+		cout << "Saldo: " << fixed << setprecision(2) << getSaldoKonta() << " PLN" << endl;
+		cout << "Oprocentowanie: " << getOprocentowanie() << "%" << endl;
+		cout << "Data ostatniej kapitalizacji: " << getDataOstatniejKapitalizacji() << endl;
+		cout << "Limit wyplat miesiecznie: " << getOgraniczenieWyplat() << endl;
+		cout << "Liczba wyplat w tym miesiacu: " << getWykonaneWyplatywWMiesiacu() << "/" << getOgraniczenieWyplat() << endl;
+		cout << "Pozostale wyplaty w tym miesiacu: " << getOgraniczenieWyplat() - getWykonaneWyplatywWMiesiacu() << endl;
+		cout << "========================================" << endl;
+
+	}
+
+};
+/**
+ * @class Klient
+ * @brief Reprezentuje klienta banku.
+ *
+ *
+ *  Klasa przechowuje dane osobowe oraz udostepnia podstawowe funkcje zwiazane z uzytkownikiem
+ */
+class Klient
+{
+private:
+	string imie; ///< Imie klienta
+	string nazwisko; ///< Nazwisko klienta
+	string pesel; ///< Numer PESEL klienta
+	string login; ///< Login klienta
+	string haslo; ///< Haslo klienta
+	bool zmieniony = true; ///< Czy dane klienta zmienily sie od ostatniego zapisu
+
+	vector<KontoGlowne*> kontaUzytkownika; ///< Tablica przechowujaca konta uzytkownika
+	vector<Karta*> kartyUzytkownika; ///< Tablica przechowujaca karty uzytkownika
+	vector<uint32_t> lokatyUzytkownika; ///< Indeksy lokat uzytkownika w SystemBankowy::wszystkieLokaty
+
+public:
+	/**
+	 *@brief Domyslny konstruktor klasy Klient
+	 *
+	 * Inicjalizuje obiekt Klient z domyslnymi wartosciami.
+	 */
+	Klient() = default;
+
+	/**
+	* @brief Konstruktor parametryczny klasy Klient.
+	*
+	* Inicjalizuje obiekt Klient z podanymi parametrami.
+	*
+	* @param imie Imie klienta
+	* @param nazwisko Nazwisko klienta
+	* @param pesel Numer PESEL klienta
+	* @param login Login klienta
+	* @param haslo Haslo klienta
+	*/
+	Klient(string imie, string nazwisko, string pesel, string login, string haslo)
+	{
+		this->imie = imie;
+		this->nazwisko = nazwisko;
+		this->pesel = pesel;
+		this->login = login;
+		this->haslo = haslo;
+	}
+
+	/**
+	 *@brief Ustala imie klienta.
+	 *
+	 *@param imie Imie klienta
+	 */
+	void setImie(string imie) { this->imie = imie; zmieniony = true; }
+	/**
+	 * @brief Ustala nazwisko klienta.
+	 *
+	 * @param nazwisko Nazwisko klienta
+	 */
+	void setNazwisko(string nazwisko) { this->nazwisko = nazwisko; zmieniony = true; }
+	/**
+	 * @brief Ustala PESEL klienta.
+	 *
+	 * @param pesel Numer PESEL klienta
+	 */
+	void setPesel(string pesel) { this->pesel = pesel; zmieniony = true; }
+	/**
+	 * @brief Ustala login klienta.
+	 *
+	 * @param login Login klienta
+	 */
+	void setLogin(string login) { this->login = login; zmieniony = true; }
+	/**
+	 * @brief Ustala haslo klienta.
+	 *
+	 * @param haslo Haslo klienta
+	 */
+	void setHaslo(string haslo) { this->haslo = haslo; zmieniony = true; }
+	/**
+	 * @brief Zwraca imie klienta.
+	 *
+	 * @return Imie klienta
+	 */
+	string getImie() const { return imie; }
+	/**
+	 * @brief Zwraca nazwisko klienta.
+	 *
+	 * @return Nazwisko klienta
+	 */
+	string getNazwisko() const { return nazwisko; }
+	/**
+	 * @brief Zwraca PESEL klienta.
+	 *
+	 * @return Numer PESEL klienta
+	 */
+	string getPesel() const { return pesel; }
+	/**
+	 * @brief Zwraca login klienta.
+	 *
+	 * @return Login klienta
+	 */
+	string getLogin() const { return login; }
+	/**
+	 * @brief Zwraca haslo klienta.
+	 *
+	 * @return Haslo klienta
+	 */
+	string getHaslo() const { return haslo; }
+	/**
+	 * @brief Sprawdza, czy dane klienta zmienily sie od ostatniego zapisu.
+	 *
+	 * @return true jesli dane klienta wymagaja zapisania
+	 */
+	bool czyZmieniony() const { return zmieniony; }
+	/**
+	 * @brief Oznacza dane klienta jako zapisane.
+	 */
+	void oznaczZapisany() { zmieniony = false; }
+
+	/**
+	 * @brief Dodaje konto do listy kont uzytkownika.
+	 *
+	 * @param konto Wskaznik na obiekt konta do doania
+	 */
+	void dodajKonto(KontoGlowne* konto)
+	{
+		kontaUzytkownika.push_back(konto);
+	}
+
+	/**
+	* @brief Dodaje karte do listy kart uzytkownika.
+	*
+	* @param karta Wskaznik na obiekt karty do dodania
+	*/
+	void dodajKarte(Karta* karta)
+	{
+		kartyUzytkownika.push_back(karta);
+	}
+
+	/**
+	* @brief Dodaje lokate do listy lokat uzytkownika.
+	*
+	* Klient przechowuje tylko pozycje lokaty, wiec rozliczenie widac bez aktualizowania kopii.
+	*
+	* @param indeks Pozycja lokaty w SystemBankowy::wszystkieLokaty
+	*/
+	void dodajLokate(uint32_t indeks)
+	{
+		lokatyUzytkownika.push_back(indeks);
+	}
+
+	/**
+	* @brief Zwraca liste kont uzytkownika.
+	*
+	* @return Wektor wskaznikow na konta uzytkownika
+	*/
+	vector<KontoGlowne*>& getKontaUzytkownika()
+	{
+		return kontaUzytkownika;
+	}
+
+	/**
+	 * @brief Zwraca liste kart uzytkownika.
+	 *
+	 * @return Wektor wskaznikow na katry klientow
+	 */
+	vector<Karta*>& getKartyUzytkownika()
+	{
+		return kartyUzytkownika;
+	}
+
+	/**
+	* @brief Zwraca liste lokat uzytkownika.
+	*
+	* @return Wektor pozycji lokat klienta w SystemBankowy::wszystkieLokaty
+	*/
+	vector<uint32_t>& getLokatyUzytkownika()
+	{
+		return lokatyUzytkownika;
+	}
+
+
+	/**
+	 * @brief Znajduje konto po numerze.
+	 *
+	 * @param numerKonta Numer konta do znalezienia
+	 *
+	 * @return Wskaznik na znalezione konto lub nullptr jesli nie znaleziono
+	 */
+	KontoGlowne* znajdzKonto(const string& numerKonta)
+	{
+		for (auto& konto : kontaUzytkownika)
+		{
+			if (konto->getNumerKonta() == numerKonta)
+			{
+				return konto;
+			}
+		}
+		return nullptr; // Konto nie znalezione
 	}
 
-
+
 	/**
 	* @brief Znajduje karte po numerze.
 	*
@@ -1236,6 +2575,8 @@ public:
 	/**
 	* @brief Usuwa konto z listy kont uzytkownika.
 	*
+	* Sam obiekt konta nalezy do rejestru w SystemBankowy i nie jest tu zwalniany.
+	*
 	* @param numerKonta Numer konta do usuniecia
 	* @return true Jesli konto zostalo usuniete, false w przeciwnym razie
 	*/
@@ -1245,7 +2586,6 @@ public:
 		{
 			if ((*it)->getNumerKonta() == numerKonta)
 			{
-				delete* it; // Usuwamy konto
 				kontaUzytkownika.erase(it); // Usuwamy wskaznik z wektora
 				return true; // Konto usuniete
 			}
@@ -1256,6 +2596,8 @@ public:
 	/**
 	* @brief Usuwa karte z listy kart uzytkownika.
 	*
+	* Sam obiekt karty nalezy do rejestru w SystemBankowy i nie jest tu zwalniany.
+	*
 	* @param numerKarty Numer karty do usuniecia
 	* @return true Jesli karta zostala usunieta, false w przeciwnym razie
 	*/
@@ -1265,7 +2607,6 @@ public:
 		{
 			if ((*it)->getNumerKarty() == numerKarty)
 			{
-				delete* it; // Usuwamy karte
 				kartyUzytkownika.erase(it); // Usuwamy wskaznik z wektora
 				return true; // Karta usunieta
 			}
@@ -1364,34 +2705,668 @@ public:
 				cout << "\n";
 			}
 		}
-
+
+	}
+
+	/**
+	* @brief Wyswietla wszystkie lokaty uzytkownika.
+	*
+	* Funkcja wyswietla wszystkie lokaty uzytkownika, ich numery, salda i oprocentowanie.
+	*
+	* @param wszystkieLokaty Lokaty banku, na ktore wskazuja indeksy klienta
+	*/
+	void wyswietlLokaty(const vector<Lokata>& wszystkieLokaty)
+	{
+		cout << "===== LOKATY =====" << endl;
+		if (lokatyUzytkownika.empty())
+		{
+			cout << "Brak lokat." << endl;
+		}
+		else
+		{
+			for (size_t i = 0; i < lokatyUzytkownika.size(); i++)
+			{
+				cout << "Lokata" << (i + 1) << ":\n";
+				wszystkieLokaty[lokatyUzytkownika[i]].wyswietlInformacje();
+				cout << "\n";
+			}
+		}
+
+	}
+
+};
+/**
+ * @class MapowanyPlik
+ * @brief Plik zmapowany do pamieci tylko do odczytu.
+ *
+ * Opakowuje CreateFileMapping/MapViewOfFile (Windows) lub mmap (POSIX),
+ * zeby migawke binarna mozna bylo czytac bez kopiowania calego pliku do bufora.
+ */
+class MapowanyPlik
+{
+private:
+	const char* dane; ///< Poczatek zmapowanego obszaru
+	size_t rozmiar; ///< Rozmiar pliku w bajtach
+#ifdef _WIN32
+	HANDLE plik; ///< Uchwyt pliku
+	HANDLE mapowanie; ///< Uchwyt mapowania
+#endif
+public:
+	/**
+	 * @brief Mapuje plik o podanej nazwie.
+	 *
+	 * Jesli pliku nie ma lub nie da sie go zmapowac, czyOtwarty() zwraca false.
+	 *
+	 * @param nazwa Nazwa pliku
+	 */
+	explicit MapowanyPlik(const string& nazwa) : dane(nullptr), rozmiar(0)
+	{
+#ifdef _WIN32
+		mapowanie = nullptr;
+		plik = CreateFileA(nazwa.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (plik == INVALID_HANDLE_VALUE) return;
+		LARGE_INTEGER wielkosc;
+		if (!GetFileSizeEx(plik, &wielkosc) || wielkosc.QuadPart == 0) return;
+		mapowanie = CreateFileMappingA(plik, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapowanie == nullptr) return;
+		dane = static_cast<const char*>(MapViewOfFile(mapowanie, FILE_MAP_READ, 0, 0, 0));
+		if (dane != nullptr) rozmiar = static_cast<size_t>(wielkosc.QuadPart);
+#else
+		int fd = open(nazwa.c_str(), O_RDONLY);
+		if (fd < 0) return;
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0)
+		{
+			void* adres = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (adres != MAP_FAILED)
+			{
+				dane = static_cast<const char*>(adres);
+				rozmiar = static_cast<size_t>(st.st_size);
+			}
+		}
+		close(fd);
+#endif
+	}
+	/**
+	 * @brief Zwalnia mapowanie i zamyka plik.
+	 */
+	~MapowanyPlik()
+	{
+#ifdef _WIN32
+		if (dane != nullptr) UnmapViewOfFile(dane);
+		if (mapowanie != nullptr) CloseHandle(mapowanie);
+		if (plik != INVALID_HANDLE_VALUE) CloseHandle(plik);
+#else
+		if (dane != nullptr) munmap(const_cast<char*>(dane), rozmiar);
+#endif
+	}
+	MapowanyPlik(const MapowanyPlik&) = delete;
+	MapowanyPlik& operator=(const MapowanyPlik&) = delete;
+
+	/**
+	 * @brief Sprawdza, czy plik zostal zmapowany.
+	 *
+	 * @return true jesli dane sa dostepne
+	 */
+	bool czyOtwarty() const { return dane != nullptr; }
+	/**
+	 * @brief Zwraca wskaznik na poczatek danych.
+	 *
+	 * @return Wskaznik na zmapowane dane
+	 */
+	const char* getDane() const { return dane; }
+	/**
+	 * @brief Zwraca rozmiar pliku.
+	 *
+	 * @return Rozmiar w bajtach
+	 */
+	size_t getRozmiar() const { return rozmiar; }
+};
+
+/**
+ * @brief Struktury migawki binarnej.
+ *
+ * Migawka to naglowek, tablice rekordow stalej dlugosci dla kazdego rodzaju danych
+ * oraz tablica napisow, do ktorej rekordy odwoluja sie przez (pozycja, dlugosc).
+ * Liczby zapisywane sa w kolejnosci bajtow maszyny (little-endian na x86/x64).
+ */
+namespace Migawka
+{
+	const char MAGIA[4] = { 'W', 'B', 'N', 'K' }; ///< Sygnatura pliku
+	const uint32_t WERSJA = 9; ///< Wersja formatu, zwiekszana przy kazdej zmianie rekordow
+
+	/// Rodzaje danych w kolejnosci sekcji
+	enum Sekcja { KLIENCI = 0, KONTA, KARTY, LOKATY, TRANSAKCJE, NUMERY_KONT, LICZBA_SEKCJI };
+
+	/// Odwolanie do napisu w tablicy napisow
+	struct Napis { uint32_t pozycja; uint32_t dlugosc; };
+
+	struct Naglowek
+	{
+		char magia[4];
+		uint32_t wersja;
+		uint64_t pokolenie; ///< Numer punktu kontrolnego; wpisy dziennika z mniejszym numerem sa juz w migawce
+		uint64_t liczba[LICZBA_SEKCJI]; ///< Liczba rekordow w sekcji
+		uint64_t przesuniecie[LICZBA_SEKCJI]; ///< Poczatek sekcji w pliku
+		uint64_t przesuniecieNapisow; ///< Poczatek tablicy napisow
+		uint64_t rozmiarNapisow; ///< Rozmiar tablicy napisow
+	};
+
+	struct RekordKlienta { Napis imie, nazwisko, pesel, login, haslo; };
+
+	struct RekordKonta
+	{
+		Napis typ, wlasciciel;
+		uint32_t numer; ///< Indeks w sekcji NUMERY_KONT
+		float oprocentowanie;
+		int64_t saldo; ///< W groszach
+		int32_t limitWyplat;
+		uint32_t oszczednosciowe; ///< 1 dla KontoOszczednosciowe
+		uint32_t miesiacKapitalizacji; ///< Data RRRRMM (0 - niepoprawna)
+		int32_t wykonaneWyplaty; ///< Liczba wyplat w miesiacu miesiacWyplat
+		uint32_t miesiacWyplat; ///< Data RRRRMM
+		uint32_t zarezerwowane;
+	};
+
+	struct RekordKarty
+	{
+		Napis numer, cvc, pin, typ;
+		uint32_t powiazaneKonto; ///< Indeks w sekcji NUMERY_KONT
+		uint32_t miesiacWaznosci; ///< Data RRRRMM (0 - niepoprawna)
+		int64_t dziennyLimit; ///< W groszach
+		int64_t wydaneDzisiaj; ///< W groszach, suma platnosci z dnia dzienWydatkow
+		uint32_t dzienWydatkow; ///< Data RRRRMMDD
+		uint32_t zarezerwowane;
+	};
+
+	struct RekordLokaty
+	{
+		uint32_t miesiacOddania; ///< Data RRRRMM (0 - niepoprawna)
+		uint32_t powiazaneKonto; ///< Indeks w sekcji NUMERY_KONT
+		float oprocentowanie;
+		uint32_t stan; ///< Bit 0 - lokata wyplacona na powiazane konto, bit 1 - usunieta razem z kontem (w starszych migawkach zawsze 0)
+		int64_t kwota; ///< W groszach
+	};
+
+	struct RekordTransakcji
+	{
+		int64_t kwota; ///< W groszach
+		int64_t czas; ///< Sekundy od 1970 roku (0 - nieznany)
+		uint32_t nadawca, odbiorca; ///< Indeksy w sekcji NUMERY_KONT
+		uint32_t miesiac; ///< Data RRRRMM
+		uint8_t typ; ///< TypTransakcji
+		uint8_t zarezerwowane[3];
+	};
+
+	/// Sekcja NUMERY_KONT to tablica Napis - numery kont ze SlownikNumerow w kolejnosci identyfikatorow
+
+	static_assert(sizeof(Naglowek) == 128, "Niepoprawny rozmiar naglowka migawki");
+	static_assert(sizeof(RekordKlienta) == 40, "Niepoprawny rozmiar rekordu klienta");
+	static_assert(sizeof(RekordKonta) == 56, "Niepoprawny rozmiar rekordu konta");
+	static_assert(sizeof(RekordKarty) == 64, "Niepoprawny rozmiar rekordu karty");
+	static_assert(sizeof(RekordLokaty) == 24, "Niepoprawny rozmiar rekordu lokaty");
+	static_assert(sizeof(RekordTransakcji) == 32, "Niepoprawny rozmiar rekordu transakcji");
+
+	/**
+	 * @class TablicaNapisow
+	 * @brief Buduje tablice napisow migawki, zapisujac powtarzajace sie napisy tylko raz.
+	 */
+	class TablicaNapisow
+	{
+	private:
+		string bufor; ///< Zawartosc tablicy napisow
+		unordered_map<string, Napis> indeks; ///< Napisy juz zapisane w buforze
+	public:
+		/**
+		 * @brief Dodaje napis do tablicy.
+		 *
+		 * @param napis Napis do dodania
+		 * @return Odwolanie do napisu w tablicy
+		 */
+		Napis dodaj(const string& napis)
+		{
+			auto it = indeks.find(napis);
+			if (it != indeks.end()) return it->second;
+			Napis odwolanie = { static_cast<uint32_t>(bufor.size()), static_cast<uint32_t>(napis.size()) };
+			bufor += napis;
+			indeks.emplace(napis, odwolanie);
+			return odwolanie;
+		}
+		/**
+		 * @brief Zwraca zawartosc tablicy.
+		 *
+		 * @return Bufor z napisami
+		 */
+		const string& getBufor() const { return bufor; }
+	};
+}
+
+/**
+ * @class CzytnikTransakcjiSAX
+ * @brief Strumieniowy czytnik historii transakcji.
+ *
+ * Odbiera zdarzenia parsera SAX z json.hpp i tworzy obiekty Transakcja od razu po
+ * przeczytaniu kazdego rekordu, bez budowania drzewa JSON calego pliku. Poza wynikowym
+ * wektorem pamiec zajmuja tylko pola biezacego rekordu.
+ */
+class CzytnikTransakcjiSAX : public json::json_sax_t
+{
+private:
+	vector<Transakcja>& transakcje; ///< Wektor, do ktorego trafiaja wczytane transakcje
+	int glebokosc; ///< Poziom zagniezdzenia (1 - tablica, 2 - rekord transakcji)
+	string_t klucz; ///< Nazwa biezacego pola rekordu (metoda string() przeslania nazwe typu)
+	double kwota; ///< Pola biezacego rekordu
+	int64_t czas; ///< Pole opcjonalne, 0 jesli go brak
+	string_t typ, data, nadawca, odbiorca;
+	unsigned wczytanePola; ///< Maska pol wczytanych w biezacym rekordzie
+
+	enum { POLE_KWOTA = 1, POLE_TYP = 2, POLE_DATA = 4, POLE_NADAWCA = 8, POLE_ODBIORCA = 16, WSZYSTKIE_POLA = 31 };
+
+	/**
+	 * @brief Zapamietuje wartosc liczbowa biezacego pola.
+	 */
+	bool liczba(double wartosc)
+	{
+		if (glebokosc == 2 && klucz == "kwota")
+		{
+			kwota = wartosc;
+			wczytanePola |= POLE_KWOTA;
+		}
+		else if (glebokosc == 2 && klucz == "czas")
+		{
+			czas = static_cast<int64_t>(wartosc);
+		}
+		return true;
+	}
+public:
+	/**
+	 * @brief Konstruktor czytnika.
+	 *
+	 * @param wynik Wektor, do ktorego beda dopisywane transakcje
+	 */
+	explicit CzytnikTransakcjiSAX(vector<Transakcja>& wynik)
+		: transakcje(wynik), glebokosc(0), kwota(0.0), czas(0), wczytanePola(0) {}
+
+	bool null() override { return true; }
+	bool boolean(bool) override { return true; }
+	bool number_integer(number_integer_t wartosc) override { return liczba(static_cast<double>(wartosc)); }
+	bool number_unsigned(number_unsigned_t wartosc) override { return liczba(static_cast<double>(wartosc)); }
+	bool number_float(number_float_t wartosc, const string_t&) override { return liczba(wartosc); }
+	bool binary(binary_t&) override { return true; }
+
+	bool string(string_t& wartosc) override
+	{
+		if (glebokosc != 2) return true;
+		if (klucz == "typ") { typ.swap(wartosc); wczytanePola |= POLE_TYP; }
+		else if (klucz == "data") { data.swap(wartosc); wczytanePola |= POLE_DATA; }
+		else if (klucz == "nadawca") { nadawca.swap(wartosc); wczytanePola |= POLE_NADAWCA; }
+		else if (klucz == "odbiorca") { odbiorca.swap(wartosc); wczytanePola |= POLE_ODBIORCA; }
+		return true;
+	}
+
+	bool start_object(size_t) override
+	{
+		glebokosc++;
+		wczytanePola = 0;
+		czas = 0;
+		return true;
+	}
+
+	bool key(string_t& wartosc) override
+	{
+		klucz.swap(wartosc);
+		return true;
+	}
+
+	bool end_object() override
+	{
+		if (glebokosc == 2)
+		{
+			if (wczytanePola != WSZYSTKIE_POLA)
+			{
+				throw Error("Niekompletny rekord transakcji.");
+			}
+			// Kolejnosc jak w from_json_Transakcja - walidacja kont zalezy od typu
+			Transakcja transakcja;
+			transakcja.setKwota(Pieniadze::zZlotych(kwota));
+			transakcja.setTypTransakcji(typ);
+			transakcja.setDataTransakcji(data);
+			transakcja.setKontoNadawcy(nadawca);
+			transakcja.setKontoOdbiorcy(odbiorca);
+			transakcja.setZnacznikCzasu(czas);
+			transakcje.push_back(transakcja);
+		}
+		glebokosc--;
+		return true;
+	}
+
+	bool start_array(size_t) override
+	{
+		glebokosc++;
+		return true;
+	}
+
+	bool end_array() override
+	{
+		glebokosc--;
+		return true;
+	}
+
+	bool parse_error(size_t pozycja, const std::string&, const nlohmann::detail::exception& e) override
+	{
+		throw Error("Blad w pozycji " + to_string(pozycja) + ": " + e.what());
+	}
+};
+
+/**
+ * @class PlikDopisywany
+ * @brief Plik otwarty do dopisywania z mozliwoscia wymuszenia zapisu na dysk.
+ *
+ * ofstream nie pozwala wywolac fsync, dlatego dziennik korzysta bezposrednio
+ * z WriteFile/FlushFileBuffers (Windows) lub write/fsync (POSIX).
+ */
+class PlikDopisywany
+{
+private:
+	string nazwa; ///< Nazwa pliku
+#ifdef _WIN32
+	HANDLE uchwyt; ///< Uchwyt pliku
+#else
+	int deskryptor; ///< Deskryptor pliku
+#endif
+public:
+	/**
+	 * @brief Otwiera (lub tworzy) plik do dopisywania.
+	 *
+	 * @param nazwa Nazwa pliku
+	 */
+	explicit PlikDopisywany(const string& nazwa) : nazwa(nazwa)
+	{
+#ifdef _WIN32
+		uchwyt = INVALID_HANDLE_VALUE;
+#else
+		deskryptor = -1;
+#endif
+		otworz();
+	}
+	/**
+	 * @brief Zamyka plik.
+	 */
+	~PlikDopisywany() { zamknij(); }
+	PlikDopisywany(const PlikDopisywany&) = delete;
+	PlikDopisywany& operator=(const PlikDopisywany&) = delete;
+
+	/**
+	 * @brief Otwiera plik, jesli nie jest otwarty.
+	 *
+	 * @return true jesli plik jest otwarty
+	 */
+	bool otworz()
+	{
+#ifdef _WIN32
+		if (uchwyt == INVALID_HANDLE_VALUE)
+		{
+			uchwyt = CreateFileA(nazwa.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		}
+		return uchwyt != INVALID_HANDLE_VALUE;
+#else
+		if (deskryptor < 0)
+		{
+			deskryptor = open(nazwa.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+		}
+		return deskryptor >= 0;
+#endif
+	}
+	/**
+	 * @brief Zamyka plik.
+	 */
+	void zamknij()
+	{
+#ifdef _WIN32
+		if (uchwyt != INVALID_HANDLE_VALUE) CloseHandle(uchwyt);
+		uchwyt = INVALID_HANDLE_VALUE;
+#else
+		if (deskryptor >= 0) close(deskryptor);
+		deskryptor = -1;
+#endif
+	}
+	/**
+	 * @brief Dopisuje dane na koniec pliku.
+	 *
+	 * @param dane Dane do dopisania
+	 * @return true jesli wszystkie dane zostaly zapisane
+	 */
+	bool dopisz(const string& dane)
+	{
+		return dopisz(dane.data(), dane.size());
+	}
+	/**
+	 * @brief Dopisuje blok bajtow na koniec pliku.
+	 *
+	 * @param dane Poczatek bloku
+	 * @param rozmiar Liczba bajtow
+	 * @return true jesli wszystkie dane zostaly zapisane
+	 */
+	bool dopisz(const char* dane, size_t rozmiar)
+	{
+		if (!otworz()) return false;
+		size_t zapisane = 0;
+		while (zapisane < rozmiar)
+		{
+#ifdef _WIN32
+			DWORD n = 0;
+			DWORD porcja = static_cast<DWORD>(min<size_t>(rozmiar - zapisane, 1u << 30));
+			if (!WriteFile(uchwyt, dane + zapisane, porcja, &n, nullptr)) return false;
+#else
+			ssize_t n = write(deskryptor, dane + zapisane, rozmiar - zapisane);
+			if (n < 0) return false;
+#endif
+			zapisane += static_cast<size_t>(n);
+		}
+		return true;
+	}
+	/**
+	 * @brief Wymusza zapis danych pliku na dysk (fsync).
+	 *
+	 * @return true jesli operacja sie powiodla
+	 */
+	bool synchronizuj()
+	{
+#ifdef _WIN32
+		return uchwyt != INVALID_HANDLE_VALUE && FlushFileBuffers(uchwyt) != 0;
+#else
+		return deskryptor >= 0 && fsync(deskryptor) == 0;
+#endif
+	}
+	/**
+	 * @brief Obcina plik do zera.
+	 */
+	void wyczysc()
+	{
+		zamknij();
+		ofstream plik(nazwa, ios::trunc);
+		plik.close();
+		otworz();
+	}
+};
+
+/**
+ * @brief Tryby trwalosci zapisow do dziennika.
+ */
+enum class TrybTrwalosci
+{
+	SYNCHRONICZNY, ///< Kazda operacja czeka na wlasny fsync
+	GRUPOWY, ///< Operacje z jednego okna czasowego czekaja na wspolny fsync
+	ASYNCHRONICZNY ///< Operacja wraca od razu, fsync wykonuje watek zapisu w tle
+};
+
+/**
+ * @class WatekZapisu
+ * @brief Watek zapisujacy wpisy dziennika w tle.
+ *
+ * Wpisy trafiaja do kolejki, a watek zbiera wszystkie wpisy, ktore nadeszly w oknie
+ * grupowania, zapisuje je jednym wywolaniem i wykonuje jeden fsync na cala grupe.
+ * Kazdy wpis dostaje numer, na ktorego utrwalenie mozna poczekac.
+ *
+ * Nieudany zapis lub fsync moze zostawic w pliku uciety wiersz, za ktorym odtwarzanie
+ * nic juz nie odczyta, wiec od pierwszego blednego wpisu zaden kolejny nie jest uznawany
+ * za utrwalony, dopoki dziennik nie zostanie wyczyszczony po zapisaniu migawki.
+ */
+class WatekZapisu
+{
+private:
+	PlikDopisywany plik; ///< Plik dziennika
+	mutex blokada; ///< Chroni kolejke i liczniki
+	condition_variable sygnalZapisu; ///< Budzi watek zapisu
+	condition_variable sygnalTrwalosci; ///< Budzi czekajacych na utrwalenie
+	string kolejka; ///< Wpisy czekajace na zapis
+	uint64_t numerDodanego; ///< Numer ostatniego dodanego wpisu
+	uint64_t numerTrwalego; ///< Numer ostatniego wpisu, ktorego zapis zostal zakonczony
+	uint64_t pierwszyBledny; ///< Numer pierwszego wpisu z nieudanej grupy (BRAK_BLEDU - wszystkie zapisane)
+	bool pilne; ///< Czy ktos czeka na natychmiastowy zapis
+	bool koniec; ///< Czy watek ma sie zakonczyc
+	chrono::milliseconds oknoGrupowania; ///< Czas zbierania wpisow do jednej grupy
+	thread watek; ///< Watek zapisu
+
+	static const uint64_t BRAK_BLEDU = UINT64_MAX;
+
+	/**
+	 * @brief Glowna petla watku zapisu.
+	 */
+	void petla()
+	{
+		unique_lock<mutex> lock(blokada);
+		while (true)
+		{
+			sygnalZapisu.wait(lock, [this] { return koniec || !kolejka.empty(); });
+			if (kolejka.empty()) break; // koniec i nic do zapisania
+
+			if (!koniec && !pilne && oknoGrupowania.count() > 0)
+			{
+				sygnalZapisu.wait_for(lock, oknoGrupowania, [this] { return koniec || pilne; });
+			}
+
+			string grupa;
+			grupa.swap(kolejka);
+			uint64_t numerGrupy = numerDodanego;
+			pilne = false;
+			lock.unlock();
+
+			bool zapisano = plik.dopisz(grupa) && plik.synchronizuj();
+
+			lock.lock();
+			if (!zapisano && pierwszyBledny == BRAK_BLEDU) pierwszyBledny = numerTrwalego + 1;
+			numerTrwalego = numerGrupy;
+			sygnalTrwalosci.notify_all();
+		}
+	}
+public:
+	/**
+	 * @brief Otwiera plik dziennika i uruchamia watek zapisu.
+	 *
+	 * @param nazwa Nazwa pliku dziennika
+	 * @param okno Okno grupowania zapisow
+	 */
+	WatekZapisu(const string& nazwa, chrono::milliseconds okno)
+		: plik(nazwa), numerDodanego(0), numerTrwalego(0), pierwszyBledny(BRAK_BLEDU), pilne(false), koniec(false), oknoGrupowania(okno)
+	{
+		watek = thread(&WatekZapisu::petla, this);
+	}
+	/**
+	 * @brief Zapisuje pozostale wpisy i konczy watek.
+	 */
+	~WatekZapisu()
+	{
+		{
+			lock_guard<mutex> lock(blokada);
+			koniec = true;
+		}
+		sygnalZapisu.notify_one();
+		watek.join();
 	}
 
 	/**
-	* @brief Wyswietla wszystkie lokaty uzytkownika.
-	*
-	* Funkcja wyswietla wszystkie lokaty uzytkownika, ich numery, salda i oprocentowanie.
-	*/
-	void wyswietlLokaty()
+	 * @brief Ustala okno grupowania zapisow.
+	 *
+	 * @param okno Czas zbierania wpisow do jednej grupy
+	 */
+	void setOknoGrupowania(chrono::milliseconds okno)
 	{
-		cout << "===== LOKATY =====" << endl;
-		if (lokatyUzytkownika.empty())
+		lock_guard<mutex> lock(blokada);
+		oknoGrupowania = okno;
+	}
+	/**
+	 * @brief Dodaje wpis do kolejki.
+	 *
+	 * @param wiersz Wiersz dziennika (razem ze znakiem konca linii)
+	 * @param natychmiast true aby zapisac bez czekania na okno grupowania
+	 * @return Numer wpisu, ktory mozna przekazac do czekajNa
+	 */
+	uint64_t dodaj(const string& wiersz, bool natychmiast)
+	{
+		uint64_t numer;
 		{
-			cout << "Brak lokat." << endl;
+			lock_guard<mutex> lock(blokada);
+			kolejka += wiersz;
+			numer = ++numerDodanego;
+			if (natychmiast) pilne = true;
 		}
-		else
+		sygnalZapisu.notify_one();
+		return numer;
+	}
+	/**
+	 * @brief Czeka, az wpis o podanym numerze zostanie zapisany na dysk.
+	 *
+	 * @param numer Numer wpisu zwrocony przez dodaj
+	 * @return true jesli wpis jest utrwalony, false jesli jego zapis sie nie udal
+	 */
+	bool czekajNa(uint64_t numer)
+	{
+		unique_lock<mutex> lock(blokada);
+		sygnalTrwalosci.wait(lock, [this, numer] { return numerTrwalego >= numer; });
+		return numer < pierwszyBledny;
+	}
+	/**
+	 * @brief Sprawdza bez czekania, czy wszystkie zakonczone zapisy sie powiodly.
+	 *
+	 * @return false jesli ktorys zapis od ostatniego wyczyszczenia sie nie udal
+	 */
+	bool czyBezBledow()
+	{
+		lock_guard<mutex> lock(blokada);
+		return pierwszyBledny == BRAK_BLEDU;
+	}
+	/**
+	 * @brief Zapisuje natychmiast wszystkie oczekujace wpisy i czeka na ich utrwalenie.
+	 *
+	 * @return true jesli wszystkie wpisy sa utrwalone
+	 */
+	bool oproznij()
+	{
+		unique_lock<mutex> lock(blokada);
+		if (numerTrwalego < numerDodanego)
 		{
-			for (size_t i = 0; i < lokatyUzytkownika.size(); i++)
-			{
-				cout << "Lokata" << (i + 1) << ":\n";
-				lokatyUzytkownika[i].wyswietlInformacje();
-				cout << "\n";
-			}
+			pilne = true;
+			sygnalZapisu.notify_one();
+			sygnalTrwalosci.wait(lock, [this] { return numerTrwalego >= numerDodanego; });
 		}
-
+		return pierwszyBledny == BRAK_BLEDU;
+	}
+	/**
+	 * @brief Zapisuje oczekujace wpisy i obcina plik dziennika.
+	 *
+	 * Wywolywane po zapisaniu migawki, ktora zawiera wszystkie wpisy, wiec po obcieciu
+	 * wczesniejsze bledy zapisu przestaja miec znaczenie.
+	 */
+	void wyczysc()
+	{
+		oproznij();
+		lock_guard<mutex> lock(blokada);
+		plik.wyczysc();
+		pierwszyBledny = BRAK_BLEDU;
 	}
-
 };
+
 /**
  * @class FileManager
  * @brief Klasa do zarządzania plikami.
@@ -1403,6 +3378,11 @@ class FileManager
 private:
 	string nazwaPliku; ///< Nazwa pliku do odczytu/zapisu
 	string typ; ///< Typ konta bankowego lub karty
+	unique_ptr<WatekZapisu> watekZapisu; ///< Watek zapisujacy dziennik, uruchamiany przy pierwszym zapisie
+	TrybTrwalosci trybTrwalosci; ///< Kiedy zapis do dziennika jest uznawany za zakonczony
+	chrono::milliseconds oknoGrupowania; ///< Czas zbierania wpisow do wspolnego fsync
+	size_t liczbaWpisowDziennika; ///< Liczba wpisow w dzienniku od ostatniego punktu kontrolnego
+	uint64_t pokolenie; ///< Numer punktu kontrolnego wczytanej lub ostatnio zapisanej migawki (0 - brak migawki)
 
 
 	/**
@@ -1447,11 +3427,12 @@ private:
 	 */
 	void to_json_Transakcja(json& j, const Transakcja& transakcja)
 	{
-		j["kwota"] = transakcja.getKwota();
+		j["kwota"] = transakcja.getKwota().naZlote();
 		j["typ"] = transakcja.getTypTransakcji();
 		j["data"] = transakcja.getDataTransakcji();
 		j["nadawca"] = transakcja.getKontoNadawcy();
 		j["odbiorca"] = transakcja.getKontoOdbiorcy();
+		if (transakcja.getZnacznikCzasu() != 0) j["czas"] = transakcja.getZnacznikCzasu();
 	}
 	/**
 	 * @brief Wczytuje informacje o transakcji z formatu JSON.
@@ -1463,11 +3444,12 @@ private:
 	 */
 	void from_json_Transakcja(const json& j, Transakcja& transakcja)
 	{
-		transakcja.setKwota(j.at("kwota").get<float>());
+		transakcja.setKwota(Pieniadze::zZlotych(j.at("kwota").get<double>()));
 		transakcja.setTypTransakcji(j.at("typ").get<string>());
 		transakcja.setDataTransakcji(j.at("data").get<string>());
 		transakcja.setKontoNadawcy(j.at("nadawca").get<string>());
 		transakcja.setKontoOdbiorcy(j.at("odbiorca").get<string>());
+		transakcja.setZnacznikCzasu(j.value("czas", int64_t(0)));
 	}
 	/**
 	 * @brief Zwraca informacje o karcie w formacie JSON.
@@ -1488,7 +3470,12 @@ private:
 		if (const KartaDebetowa* debetowa = dynamic_cast<const KartaDebetowa*>(&karta))
 		{
 			j["powiazane_konto"] = debetowa->getPowiazaneKonto();
-			j["dzienny_limit"] = debetowa->getDziennyLimit();
+			j["dzienny_limit"] = debetowa->getDziennyLimit().naZlote();
+			if (debetowa->getDzienWydatkow() != 0)
+			{
+				j["wydane_dzisiaj"] = debetowa->getLicznikWydatkow().naZlote();
+				j["dzien_wydatkow"] = debetowa->getDzienWydatkow();
+			}
 		}
 
 	}
@@ -1511,8 +3498,12 @@ private:
 		if (typ == "Debetowa")
 		{
 			string konto = j.at("powiazane_konto").get<string>();
-			float limit = j.at("dzienny_limit").get<float>();
-			return new KartaDebetowa(numer, data, cvc, konto, limit);
+			Pieniadze limit = Pieniadze::zZlotych(j.at("dzienny_limit").get<double>());
+			KartaDebetowa* karta = new KartaDebetowa(numer, data, cvc, konto, limit);
+			string pin = j.value("pin", string());
+			if (!pin.empty()) karta->setPin(pin);
+			karta->setWydaneDzisiaj(Pieniadze::zZlotych(j.value("wydane_dzisiaj", 0.0)), j.value("dzien_wydatkow", 0u));
+			return karta;
 		}
 		return nullptr;
 	}
@@ -1526,10 +3517,12 @@ private:
 	 */
 	void to_json_Lokata(json& j, const Lokata& lokata)
 	{
-		j["kwota"] = lokata.getKwota();
+		j["kwota"] = lokata.getKwota().naZlote();
 		j["oprocentowanie"] = lokata.getOprocentowanie();
 		j["data_oddania"] = lokata.getDataOddania();
 		j["powiazane_konto"] = lokata.getPowiazaneKonto();
+		if (lokata.czyRozliczona()) j["rozliczona"] = true;
+		if (lokata.czyUsunieta()) j["usunieta"] = true;
 	}
 	/**
 	 * @brief Wczytuje informacje o lokacie z formatu JSON.
@@ -1541,10 +3534,12 @@ private:
 	 */
 	void from_json_Lokata(const json& j, Lokata& lokata)
 	{
-		lokata.setKwota(j.at("kwota").get<float>());
+		lokata.setKwota(Pieniadze::zZlotych(j.at("kwota").get<double>()));
 		lokata.setOprocentowanie(j.at("oprocentowanie").get<float>());
-		lokata.setDataOddania(j.at("data_oddania").get<string>());
+		lokata.setMiesiacOddania(Kalendarz::spakujMiesiac(j.at("data_oddania").get<string>())); // Zapisana niepoprawna data (pusta) nie przerywa wczytywania
 		lokata.setPowiazaneKonto(j.at("powiazane_konto").get<string>());
+		lokata.setRozliczona(j.value("rozliczona", false));
+		lokata.setUsunieta(j.value("usunieta", false));
 
 	}
 	/**
@@ -1559,7 +3554,7 @@ private:
 	{
 		j["numer"] = konto.getNumerKonta();
 		j["typ"] = konto.getTypKonta();
-		j["saldo"] = konto.getSaldoKonta();
+		j["saldo"] = konto.getSaldoKonta().naZlote();
 
 
 		if (const KontoOszczednosciowe* oszcz = dynamic_cast<const KontoOszczednosciowe*>(&konto))
@@ -1567,6 +3562,11 @@ private:
 			j["oprocentowanie"] = oszcz->getOprocentowanie();
 			j["data_kapitalizacji"] = oszcz->getDataOstatniejKapitalizacji();
 			j["limit_wyplat"] = oszcz->getOgraniczenieWyplat();
+			if (oszcz->getMiesiacWyplat() != 0)
+			{
+				j["wykonane_wyplaty"] = oszcz->getLicznikWyplat();
+				j["miesiac_wyplat"] = Kalendarz::formatujMiesiac(oszcz->getMiesiacWyplat());
+			}
 			j["wlasciciel"] = konto.getWlasciciel();
 		}
 		else
@@ -1585,7 +3585,7 @@ private:
 	{
 		string typ = j.at("typ").get<string>();
 		string numer = j.at("numer").get<string>();
-		float saldo = j.at("saldo").get<float>();
+		Pieniadze saldo = Pieniadze::zZlotych(j.at("saldo").get<double>());
 		string wlasciciel = j.at("wlasciciel").get<string>();
 
 		KontoGlowne* noweKonto = nullptr;
@@ -1595,7 +3595,9 @@ private:
 			float oprocentowanie = j.at("oprocentowanie").get<float>();
 			string data = j.at("data_kapitalizacji").get<string>();
 			int limit = j.at("limit_wyplat").get<int>();
-			noweKonto = new KontoOszczednosciowe(numer, saldo, oprocentowanie, data, limit);
+			KontoOszczednosciowe* oszcz = new KontoOszczednosciowe(numer, saldo, oprocentowanie, data, limit);
+			oszcz->setWykonaneWyplaty(j.value("wykonane_wyplaty", 0), Kalendarz::spakujMiesiac(j.value("miesiac_wyplat", string())));
+			noweKonto = oszcz;
 		}
 		else
 		{
@@ -1619,23 +3621,243 @@ public:
 	* @param nazwa Nazwa pliku do odczytu/zapisu
 	*/
 	FileManager(const string& nazwa = "dane.json")
-		: nazwaPliku(nazwa) {}
+		: nazwaPliku(nazwa), trybTrwalosci(TrybTrwalosci::GRUPOWY),
+		oknoGrupowania(5), liczbaWpisowDziennika(0), pokolenie(0) {}
+
+
+	/**
+	 * @brief Zapisuje dane klientów do pliku JSON.
+	 * @param klienci Wektor klientów do zapisania
+	 */
+	void zapiszKlientow(const deque<Klient>& klienci)
+	{
+		json j;
+		for (const auto& klient : klienci)
+		{
+			json klientJson;
+			to_json_Klient(klientJson, klient);
+			j.push_back(klientJson);
+		}
+		ofstream plik(nazwaPliku);
+		if (plik.is_open())
+		{
+			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
+			plik.close();
+		}
+		else
+		{
+			cout << "Nie mozna otworzyc pliku do zapisu." << endl;
+		}
+
+	}
+	/**
+	 * @brief Odczytuje dane klientów z pliku JSON.
+	 * @return Wektor klientów odczytanych z pliku
+	 */
+	deque<Klient> wczytajKlientow()
+	{
+		deque<Klient> klienci;
+		ifstream plik(nazwaPliku);
+		if (plik.is_open())
+		{
+			json j;
+			try {
+				plik >> j;
+				for (const auto& klientJson : j)
+				{
+					Klient klient;
+					from_json_Klient(klientJson, klient);
+					klienci.push_back(klient);
+				}
+			}
+				catch (const exception& e)
+				{
+					cout << "Blad odczytu pliku: " << e.what() << endl;
+				}
+
+			plik.close();
+		}
+		return klienci;
+
+	}
+	/**
+	 * @brief Zapisuje historię transakcji do pliku JSON.
+	 * @param transakcje Wektor transakcji do zapisania
+	 */
+	void zapiszTransakcje(const vector<Transakcja>& transakcje)
+	{
+		json j;
+		for (const auto& t : transakcje)
+		{
+			json transakcjaJson;
+			to_json_Transakcja(transakcjaJson, t);
+			j.push_back(transakcjaJson);
+		}
+
+		ofstream plik("transakcje_" + nazwaPliku);
+		if (plik.is_open())
+		{
+			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
+			plik.close();
+		}
+		else
+		{
+			cout << "Nie mozna otworzyc pliku do zapisu." << endl;
+		}
+	}
+	/**
+	 * @brief Wczytuje historię transakcji z pliku JSON.
+	 *
+	 * Plik jest czytany strumieniowo parserem SAX, wiec pamiec potrzebna do wczytania
+	 * nie zalezy od rozmiaru pliku - tworzony jest tylko wynikowy wektor transakcji.
+	 *
+	 * @return Wektor transakcji odczytanych z pliku
+	 */
+	vector<Transakcja> wczytajTransakcje()
+	{
+		vector<Transakcja> transakcje;
+		ifstream plik("transakcje_" + nazwaPliku, ios::binary);
+
+		if (plik.is_open())
+		{
+			try {
+				CzytnikTransakcjiSAX czytnik(transakcje);
+				json::sax_parse(plik, &czytnik);
+			}
+			catch (const exception& e)
+			{
+				cout << "Blad odczytu pliku: " << e.what() << endl;
+			}
+			plik.close();
+		}
+		return transakcje;
+	}
+	/**
+	 * @brief Zapisuje dane kart do pliku JSON.
+	 * @param karty Wektor kart do zapisania
+	 */
+	void zapiszKarty(const vector<Karta*>& karty)
+	{
+		json j;
+		for (const auto& karta : karty)
+		{
+			json kartaJson;
+			to_json_Karta(kartaJson, *karta);
+			j.push_back(kartaJson);
+		}
+		ofstream plik("karty_" + nazwaPliku);
+		if (plik.is_open())
+		{
+			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
+			plik.close();
+		}
+		else
+		{
+			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+		}
+
+	}
+	/**
+	 * @brief Wczytuje dane kart z pliku JSON.
+	 * @return Wektor kart odczytanych z pliku
+	 */
+	vector<Karta*> wczytajKarty()
+	{
+		vector<Karta*> karty;
+		ifstream plik("karty_" + nazwaPliku);
+		if (plik.is_open())
+		{
+			json j;
+			try {
+				plik >> j;
+				for (const auto& kartaJson : j)
+				{
+					Karta* karta = from_json_Karta(kartaJson);
+					if (karta != nullptr)
+					{
+						karty.push_back(karta);
+					}
+				}
+			}
+			catch (const exception& e)
+			{
+				cout << "Blad odczytu pliku: " << e.what() << endl;
+			}
+			plik.close();
+		}
+		return karty;
+
+	}
+	/**
+	 * @brief Zapisuje dane lokat do pliku JSON.
+	 * @param lokaty Wektor lokat do zapisania
+	 */
+	void zapiszLokaty(const vector<Lokata>& lokaty)
+	{
+		json j;
+		for (const auto& lokata : lokaty)
+		{
+			json lokataJson;
+			to_json_Lokata(lokataJson, lokata);
+			j.push_back(lokataJson);
+		}
+		ofstream plik("lokaty_" + nazwaPliku);
+		if (plik.is_open())
+		{
+			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
+			plik.close();
+		}
+		else
+		{
+			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+		}
+
+
+	}
+	/**
+	 * @brief Wczytuje dane lokat z pliku JSON.
+	 * @return Wektor lokat odczytanych z pliku
+	 */
+	vector<Lokata> wczytajLokaty()
+	{
+		vector<Lokata> lokaty;
+		ifstream plik("lokaty_" + nazwaPliku);
+		if (plik.is_open())
+		{
+			json j;
+			try {
+				plik >> j;
+				for (const auto& lokataJson : j)
+				{
+					Lokata lokata;
+					from_json_Lokata(lokataJson, lokata);
+					lokaty.push_back(lokata);
+				}
+			}
+			catch (const exception& e)
+			{
+				cout << "Blad odczytu pliku: " << e.what() << endl;
+			}
+			plik.close();
+		}
+		return lokaty;
 
 
+	}
 	/**
-	 * @brief Zapisuje dane klientów do pliku JSON.
-	 * @param klienci Wektor klientów do zapisania
+	 * @brief Zapisuje dane kont do pliku JSON.
+	 * @param konta Wektor kont do zapisania
 	 */
-	void zapiszKlientow(const vector<Klient>& klienci)
+	void zapiszKonta(const vector<KontoGlowne*>& konta)
 	{
 		json j;
-		for (const auto& klient : klienci)
+		for (const auto& konto : konta)
 		{
-			json klientJson;
-			to_json_Klient(klientJson, klient);
-			j.push_back(klientJson);
+			json kontoJson;
+			to_json_Konto(kontoJson, *konto);
+			j.push_back(kontoJson);
 		}
-		ofstream plik(nazwaPliku);
+		ofstream plik("konta_" + nazwaPliku);
 		if (plik.is_open())
 		{
 			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
@@ -1643,265 +3865,905 @@ public:
 		}
 		else
 		{
-			cout << "Nie mozna otworzyc pliku do zapisu." << endl;
+			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
 		}
 
+
 	}
 	/**
-	 * @brief Odczytuje dane klientów z pliku JSON.
-	 * @return Wektor klientów odczytanych z pliku
+	 * @brief Wczytuje dane kont z pliku JSON.
+	 * @return Wektor kont odczytanych z pliku
 	 */
-	vector<Klient> wczytajKlientow()
+	vector<KontoGlowne*> wczytajKonta()
 	{
-		vector<Klient> klienci;
-		ifstream plik(nazwaPliku);
+		vector<KontoGlowne*> konta;
+		ifstream plik("konta_" + nazwaPliku);
 		if (plik.is_open())
 		{
 			json j;
 			try {
 				plik >> j;
-				for (const auto& klientJson : j)
+				for (const auto& kontoJson : j)
 				{
-					Klient klient;
-					from_json_Klient(klientJson, klient);
-					klienci.push_back(klient);
+					KontoGlowne* konto = from_json_Konto(kontoJson);
+					if (konto != nullptr)
+					{
+						konta.push_back(konto);
+					}
 				}
 			}
-				catch (const exception& e)
-				{
-					cout << "Blad odczytu pliku: " << e.what() << endl;
-				}
-
+			catch (const exception& e)
+			{
+				cout << "Blad odczytu pliku: " << e.what() << endl;
+			}
 			plik.close();
 		}
-		return klienci;
+		return konta;
+
 
 	}
 	/**
-	 * @brief Zapisuje historię transakcji do pliku JSON.
-	 * @param transakcje Wektor transakcji do zapisania
+	 * @brief Zwraca nazwe pliku migawki binarnej (np. "dane.bin" dla "dane.json").
+	 *
+	 * @return Nazwa pliku migawki
 	 */
-	void zapiszTransakcje(const vector<Transakcja>& transakcje)
+	string nazwaMigawki() const
 	{
-		json j;
+		size_t kropka = nazwaPliku.rfind('.');
+		return (kropka == string::npos ? nazwaPliku : nazwaPliku.substr(0, kropka)) + ".bin";
+	}
+
+	/**
+	 * @brief Zapisuje wszystkie dane do migawki binarnej.
+	 *
+	 * Plik jest najpierw zapisywany pod nazwa tymczasowa, utrwalany na dysku i dopiero
+	 * wtedy atomowo podmieniany, wiec przerwany zapis ani awaria w trakcie podmiany
+	 * nie niszcza poprzedniej migawki. Nowa migawka dostaje kolejny numer pokolenia,
+	 * wiec wpisy dziennika sprzed niej sa pomijane, nawet jesli dziennik nie zostal wyczyszczony.
+	 *
+	 * @return true jesli migawka zostala zapisana
+	 */
+	bool zapiszMigawkeBinarna(const deque<Klient>& klienci, const vector<Transakcja>& transakcje,
+		const vector<Karta*>& karty, const vector<Lokata>& lokaty, const vector<KontoGlowne*>& konta)
+	{
+		using namespace Migawka;
+		TablicaNapisow napisy;
+
+		vector<RekordKlienta> rekordyKlientow;
+		rekordyKlientow.reserve(klienci.size());
+		for (const auto& klient : klienci)
+		{
+			RekordKlienta r;
+			r.imie = napisy.dodaj(klient.getImie());
+			r.nazwisko = napisy.dodaj(klient.getNazwisko());
+			r.pesel = napisy.dodaj(klient.getPesel());
+			r.login = napisy.dodaj(klient.getLogin());
+			r.haslo = napisy.dodaj(klient.getHaslo());
+			rekordyKlientow.push_back(r);
+		}
+
+		vector<RekordKonta> rekordyKont;
+		rekordyKont.reserve(konta.size());
+		for (const auto konto : konta)
+		{
+			RekordKonta r = {};
+			r.numer = konto->getIdKonta();
+			r.typ = napisy.dodaj(konto->getTypKonta());
+			r.wlasciciel = napisy.dodaj(konto->getWlasciciel());
+			r.saldo = konto->getSaldoKonta().getGrosze();
+			if (const KontoOszczednosciowe* oszcz = dynamic_cast<const KontoOszczednosciowe*>(konto))
+			{
+				r.miesiacKapitalizacji = oszcz->getMiesiacKapitalizacji();
+				r.oprocentowanie = oszcz->getOprocentowanie();
+				r.limitWyplat = oszcz->getOgraniczenieWyplat();
+				r.wykonaneWyplaty = oszcz->getLicznikWyplat();
+				r.miesiacWyplat = oszcz->getMiesiacWyplat();
+				r.oszczednosciowe = 1;
+			}
+			rekordyKont.push_back(r);
+		}
+
+		vector<RekordKarty> rekordyKart;
+		rekordyKart.reserve(karty.size());
+		for (const auto karta : karty)
+		{
+			RekordKarty r = {};
+			r.numer = napisy.dodaj(karta->getNumerKarty());
+			r.miesiacWaznosci = karta->getMiesiacWaznosci();
+			r.cvc = napisy.dodaj(karta->getKodCVC());
+			r.pin = napisy.dodaj(karta->getPin());
+			r.typ = napisy.dodaj(karta->getTypKarty());
+			if (const KartaDebetowa* debetowa = dynamic_cast<const KartaDebetowa*>(karta))
+			{
+				r.powiazaneKonto = debetowa->getIdPowiazanegoKonta();
+				r.dziennyLimit = debetowa->getDziennyLimit().getGrosze();
+				r.wydaneDzisiaj = debetowa->getLicznikWydatkow().getGrosze();
+				r.dzienWydatkow = debetowa->getDzienWydatkow();
+			}
+			rekordyKart.push_back(r);
+		}
+
+		vector<RekordLokaty> rekordyLokat;
+		rekordyLokat.reserve(lokaty.size());
+		for (const auto& lokata : lokaty)
+		{
+			RekordLokaty r = {};
+			r.miesiacOddania = lokata.getMiesiacOddania();
+			r.powiazaneKonto = lokata.getIdPowiazanegoKonta();
+			r.kwota = lokata.getKwota().getGrosze();
+			r.oprocentowanie = lokata.getOprocentowanie();
+			r.stan = (lokata.czyRozliczona() ? 1u : 0u) | (lokata.czyUsunieta() ? 2u : 0u);
+			rekordyLokat.push_back(r);
+		}
+
+		vector<RekordTransakcji> rekordyTransakcji;
+		rekordyTransakcji.reserve(transakcje.size());
 		for (const auto& t : transakcje)
 		{
-			json transakcjaJson;
-			to_json_Transakcja(transakcjaJson, t);
-			j.push_back(transakcjaJson);
+			RekordTransakcji r = {};
+			r.kwota = t.getKwota().getGrosze();
+			r.czas = t.getZnacznikCzasu();
+			r.nadawca = t.getIdNadawcy();
+			r.odbiorca = t.getIdOdbiorcy();
+			r.miesiac = t.getMiesiacTransakcji();
+			r.typ = static_cast<uint8_t>(t.getTyp());
+			rekordyTransakcji.push_back(r);
 		}
 
-		ofstream plik("transakcje_" + nazwaPliku);
-		if (plik.is_open())
+		const SlownikNumerow& slownik = SlownikNumerow::globalny();
+		vector<Napis> rekordyNumerow(slownik.size());
+		for (uint32_t id = 0; id < rekordyNumerow.size(); id++)
 		{
-			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
-			plik.close();
+			rekordyNumerow[id] = napisy.dodaj(slownik.numer(id));
 		}
-		else
+
+		Naglowek naglowek = {};
+		memcpy(naglowek.magia, MAGIA, sizeof(MAGIA));
+		naglowek.wersja = WERSJA;
+		naglowek.pokolenie = pokolenie + 1;
+		uint64_t pozycja = sizeof(Naglowek);
+		const size_t liczby[LICZBA_SEKCJI] = { rekordyKlientow.size(), rekordyKont.size(), rekordyKart.size(), rekordyLokat.size(), rekordyTransakcji.size(), rekordyNumerow.size() };
+		const size_t rozmiary[LICZBA_SEKCJI] = { sizeof(RekordKlienta), sizeof(RekordKonta), sizeof(RekordKarty), sizeof(RekordLokaty), sizeof(RekordTransakcji), sizeof(Napis) };
+		for (int s = 0; s < LICZBA_SEKCJI; s++)
 		{
-			cout << "Nie mozna otworzyc pliku do zapisu." << endl;
+			naglowek.liczba[s] = liczby[s];
+			naglowek.przesuniecie[s] = pozycja;
+			pozycja += liczby[s] * rozmiary[s];
+		}
+		naglowek.przesuniecieNapisow = pozycja;
+		naglowek.rozmiarNapisow = napisy.getBufor().size();
+
+		string nazwa = nazwaMigawki();
+		string nazwaTymczasowa = nazwa + ".tmp";
+		PlikDopisywany plik(nazwaTymczasowa);
+		plik.wyczysc();
+		if (!plik.otworz())
+		{
+			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+			return false;
 		}
+		bool zapisano =
+			plik.dopisz(reinterpret_cast<const char*>(&naglowek), sizeof(naglowek)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyKlientow.data()), rekordyKlientow.size() * sizeof(RekordKlienta)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyKont.data()), rekordyKont.size() * sizeof(RekordKonta)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyKart.data()), rekordyKart.size() * sizeof(RekordKarty)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyLokat.data()), rekordyLokat.size() * sizeof(RekordLokaty)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyTransakcji.data()), rekordyTransakcji.size() * sizeof(RekordTransakcji)) &&
+			plik.dopisz(reinterpret_cast<const char*>(rekordyNumerow.data()), rekordyNumerow.size() * sizeof(Napis)) &&
+			plik.dopisz(napisy.getBufor().data(), napisy.getBufor().size()) &&
+			plik.synchronizuj(); // Dane musza byc na dysku, zanim nowa migawka zastapi stara
+		plik.zamknij();
+		if (!zapisano)
+		{
+			cerr << "Blad zapisu migawki binarnej." << endl;
+			return false;
+		}
+
+		// Podmiana jest atomowa - w pliku jest zawsze cala stara albo cala nowa migawka
+#ifdef _WIN32
+		bool podmieniono = MoveFileExA(nazwaTymczasowa.c_str(), nazwa.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		bool podmieniono = rename(nazwaTymczasowa.c_str(), nazwa.c_str()) == 0;
+		if (podmieniono)
+		{
+			// Utrwalenie wpisu katalogu, zeby po awarii nie wrocila stara migawka
+			size_t ukosnik = nazwa.rfind('/');
+			int katalog = open(ukosnik == string::npos ? "." : nazwa.substr(0, ukosnik + 1).c_str(), O_RDONLY);
+			if (katalog >= 0)
+			{
+				fsync(katalog);
+				close(katalog);
+			}
+		}
+#endif
+		if (!podmieniono)
+		{
+			cerr << "Nie mozna podmienic migawki binarnej." << endl;
+			return false;
+		}
+		pokolenie = naglowek.pokolenie;
+		return true;
 	}
+
 	/**
-	 * @brief Wczytuje historię transakcji z pliku JSON.
-	 * @return Wektor transakcji odczytanych z pliku
+	 * @brief Wczytuje dane z migawki binarnej.
+	 *
+	 * Plik jest mapowany do pamieci, a obiekty tworzone bezposrednio z rekordow
+	 * stalej dlugosci, bez parsowania tekstu. Sekcje sa dekodowane rownolegle, a dlugie
+	 * sekcje dzielone na czesci dekodowane na osobnych watkach.
+	 *
+	 * Uszkodzona lub nieczytelna migawka nie jest traktowana jak jej brak - wtedy
+	 * pliki JSON sa starsze od migawki i import z nich nadpisalby nowsze dane.
+	 *
+	 * @return true jesli migawka zostala wczytana, false jesli pliku migawki nie ma
+	 * @throws Error jesli plik migawki istnieje, ale nie da sie go wczytac
 	 */
-	vector<Transakcja> wczytajTransakcje()
+	bool wczytajMigawkeBinarna(deque<Klient>& klienci, vector<Transakcja>& transakcje,
+		vector<Karta*>& karty, vector<Lokata>& lokaty, vector<KontoGlowne*>& konta)
 	{
-		vector<Transakcja> transakcje;
-		ifstream plik("transakcje_" + nazwaPliku);
-
-		if (plik.is_open())
+		using namespace Migawka;
+		MapowanyPlik plik(nazwaMigawki());
+		if (!plik.czyOtwarty())
 		{
-			json j;
-			try {
-				plik >> j;
-				for (const auto& item : j) {
-					Transakcja t;
-					from_json_Transakcja(item, t);
-					transakcje.push_back(t);
+			if (!ifstream(nazwaMigawki())) return false;
+			throw Error("Nie mozna odczytac migawki binarnej " + nazwaMigawki() + ". Uruchomienie przerwane, plik nie zostal zmieniony.");
+		}
+
+		try {
+			const char* dane = plik.getDane();
+			Naglowek naglowek;
+			if (plik.getRozmiar() < sizeof(naglowek)) throw Error("plik jest za krotki");
+			memcpy(&naglowek, dane, sizeof(naglowek));
+			if (memcmp(naglowek.magia, MAGIA, sizeof(MAGIA)) != 0) throw Error("niepoprawna sygnatura");
+			if (naglowek.wersja != WERSJA)
+			{
+				throw Error("nieobslugiwana wersja " + to_string(naglowek.wersja) +
+					" (dane mozna przeniesc przez --eksportuj-json w wersji programu, ktora zapisala migawke)");
+			}
+			pokolenie = naglowek.pokolenie;
+
+			const size_t rozmiary[LICZBA_SEKCJI] = { sizeof(RekordKlienta), sizeof(RekordKonta), sizeof(RekordKarty), sizeof(RekordLokaty), sizeof(RekordTransakcji), sizeof(Napis) };
+			for (int s = 0; s < LICZBA_SEKCJI; s++)
+			{
+				if (naglowek.przesuniecie[s] > plik.getRozmiar() ||
+					naglowek.liczba[s] > (plik.getRozmiar() - naglowek.przesuniecie[s]) / rozmiary[s])
+				{
+					throw Error("sekcja wykracza poza plik");
 				}
 			}
-			catch (const exception& e)
+			if (naglowek.przesuniecieNapisow > plik.getRozmiar() ||
+				naglowek.rozmiarNapisow > plik.getRozmiar() - naglowek.przesuniecieNapisow)
 			{
-				cout << "Blad odczytu pliku: " << e.what() << endl;
+				throw Error("tablica napisow wykracza poza plik");
 			}
-			plik.close();
+
+			const char* tablicaNapisow = dane + naglowek.przesuniecieNapisow;
+			auto napis = [&](const Napis& n) -> string
+			{
+				if (n.pozycja > naglowek.rozmiarNapisow || n.dlugosc > naglowek.rozmiarNapisow - n.pozycja)
+				{
+					throw Error("odwolanie poza tablice napisow");
+				}
+				return string(tablicaNapisow + n.pozycja, n.dlugosc);
+			};
+			auto rekord = [&](Sekcja sekcja, uint64_t i, void* cel, size_t rozmiar)
+			{
+				memcpy(cel, dane + naglowek.przesuniecie[sekcja] + i * rozmiar, rozmiar);
+			};
+
+			// Slownik numerow musi byc gotowy przed rownoleglym dekodowaniem transakcji
+			vector<string> numery(naglowek.liczba[NUMERY_KONT]);
+			for (size_t i = 0; i < numery.size(); i++)
+			{
+				Napis n;
+				rekord(NUMERY_KONT, i, &n, sizeof(n));
+				numery[i] = napis(n);
+			}
+			const uint32_t liczbaNumerow = static_cast<uint32_t>(numery.size());
+			SlownikNumerow::globalny().wczytaj(move(numery));
+
+			// Wektory maja docelowy rozmiar, wiec kazdy watek wypelnia wlasny zakres indeksow
+			klienci.clear();
+			klienci.resize(naglowek.liczba[KLIENCI]);
+			konta.assign(naglowek.liczba[KONTA], nullptr);
+			karty.assign(naglowek.liczba[KARTY], nullptr);
+			lokaty.resize(naglowek.liczba[LOKATY]);
+			transakcje.resize(naglowek.liczba[TRANSAKCJE]);
+
+			auto wczytajKlientow = [&](size_t od, size_t doIndeksu)
+			{
+				for (size_t i = od; i < doIndeksu; i++)
+				{
+					RekordKlienta r;
+					rekord(KLIENCI, i, &r, sizeof(r));
+					klienci[i].setImie(napis(r.imie));
+					klienci[i].setNazwisko(napis(r.nazwisko));
+					klienci[i].setPesel(napis(r.pesel));
+					klienci[i].setLogin(napis(r.login));
+					klienci[i].setHaslo(napis(r.haslo));
+				}
+			};
+			auto wczytajKonta = [&](size_t od, size_t doIndeksu)
+			{
+				for (size_t i = od; i < doIndeksu; i++)
+				{
+					RekordKonta r;
+					rekord(KONTA, i, &r, sizeof(r));
+					if (r.numer >= liczbaNumerow) throw Error("niepoprawny rekord konta");
+					KontoGlowne* konto;
+					if (r.oszczednosciowe)
+					{
+						KontoOszczednosciowe* oszcz = new KontoOszczednosciowe("", Pieniadze::zGroszy(r.saldo), r.oprocentowanie, "", r.limitWyplat);
+						oszcz->setMiesiacKapitalizacji(r.miesiacKapitalizacji);
+						oszcz->setWykonaneWyplaty(r.wykonaneWyplaty, r.miesiacWyplat);
+						konto = oszcz;
+					}
+					else
+					{
+						konto = new KontoGlowne("", napis(r.typ), Pieniadze::zGroszy(r.saldo));
+					}
+					konta[i] = konto;
+					konto->setIdKonta(r.numer);
+					konto->setWlascicielel(napis(r.wlasciciel));
+				}
+			};
+			auto wczytajKarty = [&](size_t od, size_t doIndeksu)
+			{
+				for (size_t i = od; i < doIndeksu; i++)
+				{
+					RekordKarty r;
+					rekord(KARTY, i, &r, sizeof(r));
+					if (napis(r.typ) != "Debetowa") continue;
+					if (r.powiazaneKonto >= liczbaNumerow) throw Error("niepoprawny rekord karty");
+					KartaDebetowa* karta = new KartaDebetowa(napis(r.numer), "", napis(r.cvc), "", Pieniadze::zGroszy(r.dziennyLimit));
+					karty[i] = karta;
+					karta->setIdPowiazanegoKonta(r.powiazaneKonto);
+					karta->setMiesiacWaznosci(r.miesiacWaznosci);
+					karta->setWydaneDzisiaj(Pieniadze::zGroszy(r.wydaneDzisiaj), r.dzienWydatkow);
+					if (r.pin.dlugosc > 0) karta->setPin(napis(r.pin));
+				}
+			};
+			auto wczytajLokaty = [&](size_t od, size_t doIndeksu)
+			{
+				for (size_t i = od; i < doIndeksu; i++)
+				{
+					RekordLokaty r;
+					rekord(LOKATY, i, &r, sizeof(r));
+					if (r.powiazaneKonto >= liczbaNumerow) throw Error("niepoprawny rekord lokaty");
+					lokaty[i] = Lokata(Pieniadze::zGroszy(r.kwota), r.oprocentowanie, "", "");
+					lokaty[i].setIdPowiazanegoKonta(r.powiazaneKonto);
+					lokaty[i].setMiesiacOddania(r.miesiacOddania);
+					lokaty[i].setRozliczona((r.stan & 1u) != 0);
+					lokaty[i].setUsunieta((r.stan & 2u) != 0);
+				}
+			};
+			auto wczytajTransakcje = [&](size_t od, size_t doIndeksu)
+			{
+				for (size_t i = od; i < doIndeksu; i++)
+				{
+					RekordTransakcji r;
+					rekord(TRANSAKCJE, i, &r, sizeof(r));
+					if (r.typ > static_cast<uint8_t>(TypTransakcji::ODSETKI) ||
+						r.nadawca >= liczbaNumerow || r.odbiorca >= liczbaNumerow)
+					{
+						throw Error("niepoprawny rekord transakcji");
+					}
+					Transakcja& t = transakcje[i];
+					t.setKwota(Pieniadze::zGroszy(r.kwota));
+					t.setTypTransakcji(static_cast<TypTransakcji>(r.typ));
+					t.setMiesiacTransakcji(r.miesiac);
+					t.setIdNadawcy(r.nadawca);
+					t.setIdOdbiorcy(r.odbiorca);
+					t.setZnacznikCzasu(r.czas);
+				}
+			};
+
+			// Sekcje sa dekodowane jednoczesnie, a duze sekcje dodatkowo w kilku czesciach
+			vector<future<void>> sekcje;
+			sekcje.push_back(async(launch::async, [&] { wykonajRownolegle(klienci.size(), wczytajKlientow); }));
+			sekcje.push_back(async(launch::async, [&] { wykonajRownolegle(konta.size(), wczytajKonta); }));
+			sekcje.push_back(async(launch::async, [&] { wykonajRownolegle(karty.size(), wczytajKarty); }));
+			sekcje.push_back(async(launch::async, [&] { wykonajRownolegle(lokaty.size(), wczytajLokaty); }));
+			sekcje.push_back(async(launch::async, [&] { wykonajRownolegle(transakcje.size(), wczytajTransakcje); }));
+			for (auto& sekcja : sekcje) sekcja.wait();
+			for (auto& sekcja : sekcje) sekcja.get();
+
+			karty.erase(remove(karty.begin(), karty.end(), nullptr), karty.end()); // Nieobslugiwane typy kart
 		}
-		return transakcje;
+		catch (const exception& e)
+		{
+			SlownikNumerow::globalny().wyczysc();
+			for (auto konto : konta) delete konto;
+			for (auto karta : karty) delete karta;
+			klienci.clear();
+			transakcje.clear();
+			karty.clear();
+			lokaty.clear();
+			konta.clear();
+			throw Error("Blad odczytu migawki binarnej " + nazwaMigawki() + ": " + e.what() +
+				". Uruchomienie przerwane, plik nie zostal zmieniony.");
+		}
+		return true;
 	}
+
 	/**
-	 * @brief Zapisuje dane kart do pliku JSON.
-	 * @param karty Wektor kart do zapisania
+	 * @brief Zwraca liczbe wpisow dziennika od ostatniego punktu kontrolnego.
+	 *
+	 * @return Liczba wpisow w dzienniku
 	 */
-	void zapiszKarty(const vector<Karta*>& karty)
+	size_t getLiczbaWpisowDziennika() const { return liczbaWpisowDziennika; }
+	/**
+	 * @brief Zwraca tryb trwalosci zapisow do dziennika.
+	 *
+	 * @return Tryb trwalosci
+	 */
+	TrybTrwalosci getTrybTrwalosci() const { return trybTrwalosci; }
+	/**
+	 * @brief Ustala tryb trwalosci i okno grupowania zapisow do dziennika.
+	 *
+	 * @param tryb Tryb trwalosci
+	 * @param okno Czas zbierania wpisow do wspolnego fsync (tryb grupowy i asynchroniczny)
+	 */
+	void setTrybTrwalosci(TrybTrwalosci tryb, chrono::milliseconds okno)
 	{
-		json j;
-		for (const auto& karta : karty)
-		{
-			json kartaJson;
-			to_json_Karta(kartaJson, *karta);
-			j.push_back(kartaJson);
-		}
-		ofstream plik("karty_" + nazwaPliku);
-		if (plik.is_open())
+		if (watekZapisu) watekZapisu->oproznij(); // Wpisy przyjete w starym trybie zostaja utrwalone
+		trybTrwalosci = tryb;
+		oknoGrupowania = okno;
+		if (watekZapisu) watekZapisu->setOknoGrupowania(okno);
+	}
+
+	/**
+	 * @brief Dodaje do paczki zmian operacje zapisu klienta.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param klient Klient do zapisania (identyfikowany loginem)
+	 */
+	void dodajOperacje(json& zmiany, const Klient& klient)
+	{
+		json dane;
+		to_json_Klient(dane, klient);
+		zmiany.push_back({ {"op", "klient"}, {"dane", dane} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje zapisu konta.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param konto Konto do zapisania (identyfikowane numerem)
+	 */
+	void dodajOperacje(json& zmiany, const KontoGlowne& konto)
+	{
+		json dane;
+		to_json_Konto(dane, konto);
+		zmiany.push_back({ {"op", "konto"}, {"dane", dane} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje zapisu karty.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param karta Karta do zapisania (identyfikowana numerem)
+	 */
+	void dodajOperacje(json& zmiany, const Karta& karta)
+	{
+		json dane;
+		to_json_Karta(dane, karta);
+		zmiany.push_back({ {"op", "karta"}, {"dane", dane} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje dopisania lokaty.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param lokata Nowa lokata
+	 * @param indeks Pozycja lokaty w wektorze wszystkich lokat
+	 */
+	void dodajOperacje(json& zmiany, const Lokata& lokata, size_t indeks)
+	{
+		json dane;
+		to_json_Lokata(dane, lokata);
+		zmiany.push_back({ {"op", "lokata"}, {"indeks", indeks}, {"dane", dane} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje dopisania transakcji.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param transakcja Nowa transakcja
+	 * @param indeks Pozycja transakcji w historii transakcji
+	 */
+	void dodajOperacje(json& zmiany, const Transakcja& transakcja, size_t indeks)
+	{
+		json dane;
+		to_json_Transakcja(dane, transakcja);
+		zmiany.push_back({ {"op", "transakcja"}, {"indeks", indeks}, {"dane", dane} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje usuniecia konta lub karty.
+	 *
+	 * Usuniecie konta usuwa rowniez powiazane z nim karty i lokaty.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param typ "usun_konto" lub "usun_karte"
+	 * @param numer Numer usuwanego konta lub karty
+	 */
+	void dodajUsuniecie(json& zmiany, const string& typ, const string& numer)
+	{
+		zmiany.push_back({ {"op", typ}, {"numer", numer} });
+	}
+	/**
+	 * @brief Dodaje do paczki zmian operacje rozliczenia (wyplaty) lokaty.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 * @param indeks Pozycja lokaty w wektorze wszystkich lokat
+	 */
+	void dodajRozliczenieLokaty(json& zmiany, size_t indeks)
+	{
+		zmiany.push_back({ {"op", "rozlicz_lokate"}, {"indeks", indeks} });
+	}
+
+	/**
+	 * @brief Dopisuje paczke zmian jako jeden wiersz dziennika.
+	 *
+	 * Kazda zmiana zajmuje dokladnie jeden wiersz, wiec uciety ostatni wiersz
+	 * jest pomijany przy odtwarzaniu i zmiana nie zostaje zastosowana czesciowo.
+	 * Wiersz zawiera numer pokolenia biezacej migawki, po ktorym odtwarzanie rozpoznaje
+	 * wpisy zawarte juz w nowszej migawce.
+	 * Zapis wykonuje watek zapisu; w zaleznosci od trybu trwalosci funkcja czeka
+	 * na wlasny fsync, na fsync calej grupy albo wraca od razu.
+	 *
+	 * @param zmiany Tablica JSON z operacjami zmiany
+	 * @return false jesli wpis (lub w trybie asynchronicznym ktorys wczesniejszy) nie zostal zapisany
+	 */
+	bool zapiszDoDziennika(const json& zmiany)
+	{
+		if (!watekZapisu)
 		{
-			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
-			plik.close();
+			watekZapisu.reset(new WatekZapisu("dziennik_" + nazwaPliku, oknoGrupowania));
 		}
-		else
+		json wpis = { {"pokolenie", pokolenie}, {"zmiany", zmiany} };
+		uint64_t numer = watekZapisu->dodaj(wpis.dump() + '\n', trybTrwalosci == TrybTrwalosci::SYNCHRONICZNY);
+		liczbaWpisowDziennika++;
+		if (trybTrwalosci != TrybTrwalosci::ASYNCHRONICZNY)
 		{
-			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+			return watekZapisu->czekajNa(numer);
 		}
-
+		return watekZapisu->czyBezBledow();
 	}
+
 	/**
-	 * @brief Wczytuje dane kart z pliku JSON.
-	 * @return Wektor kart odczytanych z pliku
+	 * @brief Odtwarza dziennik na danych wczytanych z ostatniego punktu kontrolnego.
+	 *
+	 * Operacje sa idempotentne: klienci, konta i karty sa nadpisywane po kluczu,
+	 * a lokaty i transakcje dopisywane tylko wtedy, gdy ich indeks nie jest jeszcze zajety.
+	 * Lokaty nigdy nie sa usuwane z wektora (tylko oznaczane), wiec ich indeksy sa stale.
+	 * Wpisy z pokolenia starszego niz wczytana migawka sa pomijane - zostaja w dzienniku
+	 * tylko wtedy, gdy awaria przerwala punkt kontrolny miedzy podmiana migawki a czyszczeniem
+	 * dziennika, a ich ponowne zastosowanie cofneloby salda zmienione przez operacje wsadowe.
+	 * Rekordy sa wyszukiwane w indeksach budowanych raz przed pierwszym wpisem, a usuniete
+	 * konta i karty zostaja usuniete z wektorow dopiero po odtworzeniu calego dziennika.
 	 */
-	vector<Karta*> wczytajKarty()
+	void odtworzDziennik(deque<Klient>& klienci, vector<Transakcja>& transakcje, vector<Karta*>& karty,
+		vector<Lokata>& lokaty, vector<KontoGlowne*>& konta)
 	{
-		vector<Karta*> karty;
-		ifstream plik("karty_" + nazwaPliku);
-		if (plik.is_open())
+		liczbaWpisowDziennika = 0;
+		ifstream plik("dziennik_" + nazwaPliku);
+		if (!plik.is_open())
 		{
-			json j;
+			return;
+		}
+
+		IndeksyOdtwarzania indeksy;
+		bool indeksyGotowe = false;
+		size_t nieaktualne = 0;
+		string wiersz;
+		while (getline(plik, wiersz))
+		{
+			if (wiersz.empty()) continue;
+
+			json wpis;
+			try {
+				wpis = json::parse(wiersz);
+			}
+			catch (const exception&)
+			{
+				cout << "Pominieto niekompletny wpis dziennika." << endl;
+				break; // Uciety moze byc tylko ostatni wpis
+			}
+			if (!wpis.is_object()) wpis = { {"pokolenie", 0}, {"zmiany", wpis} }; // Starsze wpisy byly sama tablica zmian
+			if (wpis.value("pokolenie", uint64_t(0)) < pokolenie)
+			{
+				nieaktualne++; // Wpis jest juz zawarty w migawce
+				continue;
+			}
+			if (!indeksyGotowe)
+			{
+				zbudujIndeksy(indeksy, klienci, karty, lokaty, konta);
+				indeksyGotowe = true;
+			}
+
 			try {
-				plik >> j;
-				for (const auto& kartaJson : j)
+				for (const auto& operacja : wpis.at("zmiany"))
 				{
-					Karta* karta = from_json_Karta(kartaJson);
-					if (karta != nullptr)
-					{
-						karty.push_back(karta);
-					}
+					odtworzOperacje(operacja, indeksy, klienci, transakcje, karty, lokaty, konta);
 				}
 			}
 			catch (const exception& e)
 			{
-				cout << "Blad odczytu pliku: " << e.what() << endl;
+				cout << "Blad odtwarzania dziennika: " << e.what() << endl;
 			}
-			plik.close();
+			liczbaWpisowDziennika++;
 		}
-		return karty;
+		plik.close();
+
+		// Usuniete konta i karty zostawily puste miejsca, zeby indeksy pozostaly wazne
+		konta.erase(remove(konta.begin(), konta.end(), nullptr), konta.end());
+		karty.erase(remove(karty.begin(), karty.end(), nullptr), karty.end());
 
+		if (nieaktualne > 0 && liczbaWpisowDziennika == 0)
+		{
+			wyczyscDziennik(); // Dokonczenie przerwanego punktu kontrolnego
+		}
 	}
+
 	/**
-	 * @brief Zapisuje dane lokat do pliku JSON.
-	 * @param lokaty Wektor lokat do zapisania
+	 * @brief Czysci dziennik po zapisaniu punktu kontrolnego.
 	 */
-	void zapiszLokaty(const vector<Lokata>& lokaty)
+	void wyczyscDziennik()
 	{
-		json j;
-		for (const auto& lokata : lokaty)
-		{
-			json lokataJson;
-			to_json_Lokata(lokataJson, lokata);
-			j.push_back(lokataJson);
-		}
-		ofstream plik("lokaty_" + nazwaPliku);
-		if (plik.is_open())
+		if (watekZapisu)
 		{
-			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
-			plik.close();
+			watekZapisu->wyczysc();
 		}
 		else
 		{
-			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+			ofstream plik("dziennik_" + nazwaPliku, ios::trunc);
 		}
+		liczbaWpisowDziennika = 0;
+	}
 
+private:
+	/**
+	 * @brief Pozycje wczytanych rekordow wedlug kluczy uzywanych przez operacje dziennika.
+	 */
+	struct IndeksyOdtwarzania
+	{
+		unordered_map<string, size_t> klienci; ///< Login -> pozycja klienta
+		unordered_map<uint32_t, size_t> konta; ///< Identyfikator numeru konta -> pozycja konta
+		unordered_map<string, size_t> karty; ///< Numer karty -> pozycja karty
+		unordered_map<uint32_t, vector<size_t>> kartyKonta; ///< Identyfikator numeru konta -> pozycje jego kart
+		unordered_map<uint32_t, vector<size_t>> lokatyKonta; ///< Identyfikator numeru konta -> pozycje jego lokat
+	};
 
-	}
 	/**
-	 * @brief Wczytuje dane lokat z pliku JSON.
-	 * @return Wektor lokat odczytanych z pliku
+	 * @brief Buduje indeksy wczytanych danych przed odtworzeniem dziennika.
 	 */
-	vector<Lokata> wczytajLokaty()
+	void zbudujIndeksy(IndeksyOdtwarzania& indeksy, const deque<Klient>& klienci, const vector<Karta*>& karty,
+		const vector<Lokata>& lokaty, const vector<KontoGlowne*>& konta)
 	{
-		vector<Lokata> lokaty;
-		ifstream plik("lokaty_" + nazwaPliku);
-		if (plik.is_open())
+		indeksy.klienci.reserve(klienci.size());
+		for (size_t i = 0; i < klienci.size(); i++) indeksy.klienci[klienci[i].getLogin()] = i;
+		indeksy.konta.reserve(konta.size());
+		for (size_t i = 0; i < konta.size(); i++) indeksy.konta[konta[i]->getIdKonta()] = i;
+		indeksy.karty.reserve(karty.size());
+		for (size_t i = 0; i < karty.size(); i++) dodajDoIndeksow(indeksy, karty[i], i);
+		for (size_t i = 0; i < lokaty.size(); i++)
 		{
-			json j;
-			try {
-				plik >> j;
-				for (const auto& lokataJson : j)
-				{
-					Lokata lokata;
-					from_json_Lokata(lokataJson, lokata);
-					lokaty.push_back(lokata);
-				}
-			}
-			catch (const exception& e)
-			{
-				cout << "Blad odczytu pliku: " << e.what() << endl;
-			}
-			plik.close();
+			if (!lokaty[i].czyUsunieta()) indeksy.lokatyKonta[lokaty[i].getIdPowiazanegoKonta()].push_back(i);
 		}
-		return lokaty;
-
+	}
 
+	/**
+	 * @brief Dopisuje karte z podanej pozycji do indeksow odtwarzania.
+	 */
+	static void dodajDoIndeksow(IndeksyOdtwarzania& indeksy, const Karta* karta, size_t pozycja)
+	{
+		indeksy.karty[karta->getNumerKarty()] = pozycja;
+		if (const KartaDebetowa* debetowa = dynamic_cast<const KartaDebetowa*>(karta))
+		{
+			indeksy.kartyKonta[debetowa->getIdPowiazanegoKonta()].push_back(pozycja);
+		}
 	}
+
 	/**
-	 * @brief Zapisuje dane kont do pliku JSON.
-	 * @param konta Wektor kont do zapisania
+	 * @brief Stosuje pojedyncza operacje dziennika do wczytanych danych.
+	 *
+	 * Usuniete konta i karty sa zastepowane przez nullptr, zeby nie przesuwac pozycji w indeksach.
 	 */
-	void zapiszKonta(const vector<KontoGlowne*>& konta)
+	void odtworzOperacje(const json& operacja, IndeksyOdtwarzania& indeksy, deque<Klient>& klienci, vector<Transakcja>& transakcje,
+		vector<Karta*>& karty, vector<Lokata>& lokaty, vector<KontoGlowne*>& konta)
 	{
-		json j;
-		for (const auto& konto : konta)
+		string op = operacja.at("op").get<string>();
+
+		if (op == "klient")
 		{
-			json kontoJson;
-			to_json_Konto(kontoJson, *konto);
-			j.push_back(kontoJson);
+			Klient nowy;
+			from_json_Klient(operacja.at("dane"), nowy);
+			auto it = indeksy.klienci.find(nowy.getLogin());
+			if (it != indeksy.klienci.end())
+			{
+				from_json_Klient(operacja.at("dane"), klienci[it->second]);
+				return;
+			}
+			indeksy.klienci[nowy.getLogin()] = klienci.size();
+			klienci.push_back(nowy);
 		}
-		ofstream plik("konta_" + nazwaPliku);
-		if (plik.is_open())
+		else if (op == "konto")
 		{
-			plik << j.dump(4); // Zapisujemy z wcięciem 4 spacji
-			plik.close();
+			KontoGlowne* nowe = from_json_Konto(operacja.at("dane"));
+			auto it = indeksy.konta.find(nowe->getIdKonta());
+			if (it != indeksy.konta.end())
+			{
+				delete konta[it->second];
+				konta[it->second] = nowe;
+				return;
+			}
+			indeksy.konta[nowe->getIdKonta()] = konta.size();
+			konta.push_back(nowe);
 		}
-		else
+		else if (op == "karta")
 		{
-			cerr << "Nie mozna otworzyc pliku do zapisu." << endl;
+			Karta* nowa = from_json_Karta(operacja.at("dane"));
+			if (nowa == nullptr) return;
+			auto it = indeksy.karty.find(nowa->getNumerKarty());
+			if (it != indeksy.karty.end())
+			{
+				delete karty[it->second];
+				karty[it->second] = nowa;
+				return;
+			}
+			dodajDoIndeksow(indeksy, nowa, karty.size());
+			karty.push_back(nowa);
 		}
-
-
-	}
-	/**
-	 * @brief Wczytuje dane kont z pliku JSON.
-	 * @return Wektor kont odczytanych z pliku
-	 */
-	vector<KontoGlowne*> wczytajKonta()
-	{
-		vector<KontoGlowne*> konta;
-		ifstream plik("konta_" + nazwaPliku);
-		if (plik.is_open())
+		else if (op == "lokata")
 		{
-			json j;
-			try {
-				plik >> j;
-				for (const auto& kontoJson : j)
+			if (operacja.at("indeks").get<size_t>() < lokaty.size()) return; // Juz zapisana w punkcie kontrolnym
+			Lokata lokata;
+			from_json_Lokata(operacja.at("dane"), lokata);
+			indeksy.lokatyKonta[lokata.getIdPowiazanegoKonta()].push_back(lokaty.size());
+			lokaty.push_back(lokata);
+		}
+		else if (op == "rozlicz_lokate")
+		{
+			size_t indeks = operacja.at("indeks").get<size_t>();
+			if (indeks < lokaty.size()) lokaty[indeks].setRozliczona(true);
+		}
+		else if (op == "transakcja")
+		{
+			if (operacja.at("indeks").get<size_t>() < transakcje.size()) return; // Juz zapisana w punkcie kontrolnym
+			Transakcja transakcja;
+			from_json_Transakcja(operacja.at("dane"), transakcja);
+			transakcje.push_back(transakcja);
+		}
+		else if (op == "usun_konto")
+		{
+			uint32_t id;
+			if (!SlownikNumerow::globalny().znajdz(operacja.at("numer").get<string>(), id)) return;
+			auto konto = indeksy.konta.find(id);
+			if (konto != indeksy.konta.end())
+			{
+				delete konta[konto->second];
+				konta[konto->second] = nullptr;
+				indeksy.konta.erase(konto);
+			}
+			auto kartyKonta = indeksy.kartyKonta.find(id);
+			if (kartyKonta != indeksy.kartyKonta.end())
+			{
+				for (size_t pozycja : kartyKonta->second)
 				{
-					KontoGlowne* konto = from_json_Konto(kontoJson);
-					if (konto != nullptr)
-					{
-						konta.push_back(konto);
-					}
+					if (karty[pozycja] == nullptr) continue;
+					indeksy.karty.erase(karty[pozycja]->getNumerKarty());
+					delete karty[pozycja];
+					karty[pozycja] = nullptr;
 				}
+				indeksy.kartyKonta.erase(kartyKonta);
 			}
-			catch (const exception& e)
+			auto lokatyKonta = indeksy.lokatyKonta.find(id);
+			if (lokatyKonta != indeksy.lokatyKonta.end())
 			{
-				cout << "Blad odczytu pliku: " << e.what() << endl;
+				for (size_t pozycja : lokatyKonta->second) lokaty[pozycja].setUsunieta(true);
+				indeksy.lokatyKonta.erase(lokatyKonta);
 			}
-			plik.close();
 		}
-		return konta;
+		else if (op == "usun_karte")
+		{
+			auto karta = indeksy.karty.find(operacja.at("numer").get<string>());
+			if (karta != indeksy.karty.end())
+			{
+				delete karty[karta->second];
+				karty[karta->second] = nullptr;
+				indeksy.karty.erase(karta);
+			}
+		}
+	}
+
+};
+
+/**
+ * @class Rejestr
+ * @brief Jedyny wlasciciel obiektow danego typu (kont lub kart).
+ *
+ * Klienci przechowuja jedynie wskazniki do obiektow z rejestru i nigdy ich nie zwalniaja,
+ * dzieki czemu kazdy obiekt jest usuwany dokladnie raz, a zamkniecie programu
+ * to jedno przejscie po rejestrze.
+ */
+template <typename T>
+class Rejestr
+{
+private:
+	vector<T*> elementy; ///< Obiekty nalezace do rejestru
+	unordered_map<const T*, size_t> pozycje; ///< Pozycja kazdego obiektu w elementy, zeby usuwanie nie przeszukiwalo rejestru
+
+public:
+	Rejestr() = default;
+	Rejestr(const Rejestr&) = delete;
+	Rejestr& operator=(const Rejestr&) = delete;
+
+	/**
+	 * @brief Zwalnia wszystkie obiekty rejestru.
+	 */
+	~Rejestr()
+	{
+		for (T* element : elementy) delete element;
+	}
+
+	/**
+	 * @brief Przejmuje na wlasnosc obiekty wczytane z plikow, zwalniajac dotychczasowe.
+	 *
+	 * @param nowe Wektor wskaznikow do przejecia
+	 */
+	void przejmij(vector<T*>&& nowe)
+	{
+		for (T* element : elementy) delete element;
+		elementy = move(nowe);
+		pozycje.clear();
+		pozycje.reserve(elementy.size());
+		for (size_t i = 0; i < elementy.size(); i++) pozycje[elementy[i]] = i;
+	}
 
+	/**
+	 * @brief Dodaje obiekt do rejestru, ktory od tej chwili jest jego wlascicielem.
+	 *
+	 * @param element Obiekt utworzony przez new
+	 * @return Ten sam wskaznik
+	 */
+	T* dodaj(T* element)
+	{
+		pozycje[element] = elementy.size();
+		elementy.push_back(element);
+		return element;
+	}
 
+	/**
+	 * @brief Usuwa i zwalnia podany obiekt w czasie stalym.
+	 *
+	 * Na miejsce usunietego obiektu trafia ostatni obiekt rejestru.
+	 *
+	 * @param element Obiekt do usuniecia
+	 * @return true Jesli obiekt nalezal do rejestru, false w przeciwnym razie
+	 */
+	bool usun(const T* element)
+	{
+		auto it = pozycje.find(element);
+		if (it == pozycje.end()) return false;
+		const size_t pozycja = it->second;
+		pozycje.erase(it);
+		delete elementy[pozycja];
+		if (pozycja + 1 != elementy.size())
+		{
+			elementy[pozycja] = elementy.back();
+			pozycje[elementy[pozycja]] = pozycja;
+		}
+		elementy.pop_back();
+		return true;
 	}
 
+	/**
+	 * @brief Zwraca wskazniki do obiektow w kolejnosci zapisu w plikach
+	 * (usuwanie przenosi ostatni obiekt na miejsce usunietego).
+	 */
+	const vector<T*>& getElementy() const { return elementy; }
+	size_t size() const { return elementy.size(); }
+	typename vector<T*>::const_iterator begin() const { return elementy.begin(); }
+	typename vector<T*>::const_iterator end() const { return elementy.end(); }
 };
+
 /**
 * @class SystemBankowy
 * @brief Główny kontroler systemu bankowego.
@@ -1912,110 +4774,469 @@ public:
 class SystemBankowy
 {
 private:
-	vector<Klient> klienci; ///< Wektor przechowujący klientów
+	deque<Klient> klienci; ///< Klienci banku; deque nie przenosi istniejacych klientow przy dodawaniu nowych
+	unordered_map<string, Klient*> klientPoLoginie; ///< Indeks login -> klient dla logowania i rejestracji
+	unordered_map<string, Klient*> klientPoPeselu; ///< Indeks PESEL -> klient (wlasciciel kont)
 	vector<Transakcja> transakcje; ///< Wektor przechowujący transakcje
-	vector<Karta*> wszystkieKarty;
+	Rejestr<Karta> wszystkieKarty; ///< Wlasciciel wszystkich kart
 	vector<Lokata> wszystkieLokaty;
-	vector<KontoGlowne*> wszystkieKonta;
+	map<uint32_t, vector<uint32_t>> harmonogramLokat; ///< Indeksy nierozliczonych lokat w wszystkieLokaty wedlug miesiaca oddania RRRRMM
+	Rejestr<KontoGlowne> wszystkieKonta; ///< Wlasciciel wszystkich kont
+	vector<KontoGlowne*> kontaPoId; ///< Katalog wszystkich kont banku wedlug identyfikatora numeru (nullptr - brak konta)
+	vector<vector<uint32_t>> transakcjeKonta; ///< Indeksy transakcji kazdego konta wedlug identyfikatora numeru, uporzadkowane wg kluczHistorii
+	vector<vector<Karta*>> kartyKonta; ///< Karty debetowe powiazane z kazdym kontem wedlug identyfikatora numeru
+	AutoryzacjaKart autoryzacja; ///< Indeks kart debetowych po numerze dla autoryzacji platnosci
+	SilnikPrzelewow silnikPrzelewow; ///< Przelewy wsadowe wykonywane na wielu watkach
 	Klient* zalogowanyKlient; ///< Wskaźnik na aktualnie zalogowanego klienta
 	FileManager menedzerPlikow; ///< Obiekt do zarządzania plikami
-public:
+
+	static const size_t PROG_PUNKTU_KONTROLNEGO = 1000; ///< Liczba wpisow dziennika, po ktorej dane sa zapisywane do plikow
+
+	bool niezapisaneZmiany; ///< Czy od ostatniego punktu kontrolnego cokolwiek sie zmienilo (migawka jest zapisywana w calosci)
+	size_t zapisaneLokaty; ///< Liczba lokat z poczatku wszystkieLokaty, ktore sa juz utrwalone
+	size_t zapisaneTransakcje; ///< Liczba transakcji, ktore sa juz utrwalone
+	chrono::microseconds czasWczytywania; ///< Czas wczytania danych i odtworzenia dziennika
+	chrono::microseconds czasLaczenia; ///< Czas powiazania klientow z kontami, kartami i lokatami oraz budowy indeksow
+
 	/**
-	 * @brief Konstruktor klasy SystemBankowy.
+	 * @brief Wiaze klientow z ich kontami, kartami i lokatami.
 	 *
-	 * Wczytuje dane klientów, transakcji, kart, kont i lokat z plików JSON podczas inicjalizacji.
+	 * Zamiast porownywac kazdego klienta z kazdym kontem budowane sa indeksy
+	 * PESEL -> klient i numer konta -> klient, wiec czas jest liniowy wzgledem liczby danych.
+	 * Numery kont sa identyfikatorami ze SlownikNumerow, wiec indeksy kont to zwykle wektory.
+	 * Przy okazji wypelniane sa indeksy klientPoLoginie, klientPoPeselu, kontaPoId, transakcjeKonta,
+	 * kartyKonta, indeks kart do autoryzacji oraz harmonogram lokat.
+	 * Kolejnosc kont, kart i lokat u klienta jest taka sama jak w plikach.
 	 */
-	SystemBankowy() : zalogowanyKlient(nullptr)
+	void polaczDane()
 	{
-		klienci = menedzerPlikow.wczytajKlientow();
-		transakcje = menedzerPlikow.wczytajTransakcje();
-		wszystkieKarty = menedzerPlikow.wczytajKarty();
-		wszystkieLokaty = menedzerPlikow.wczytajLokaty();
-		wszystkieKonta = menedzerPlikow.wczytajKonta();
-
+		klientPoPeselu.reserve(klienci.size());
+		klientPoLoginie.reserve(klienci.size());
 		for (auto& klient : klienci)
 		{
-			for (auto konto : wszystkieKonta)
+			klientPoPeselu.emplace(klient.getPesel(), &klient); // Przy powtorzonym PESEL wygrywa pierwszy klient
+			klientPoLoginie.emplace(klient.getLogin(), &klient);
+		}
+
+		const size_t liczbaNumerow = SlownikNumerow::globalny().size();
+		vector<Klient*> wlascicielKonta(liczbaNumerow, nullptr);
+		kontaPoId.assign(liczbaNumerow, nullptr);
+		for (auto konto : wszystkieKonta)
+		{
+			if (kontaPoId[konto->getIdKonta()] == nullptr) kontaPoId[konto->getIdKonta()] = konto;
+			auto it = klientPoPeselu.find(konto->getWlasciciel());
+			if (it == klientPoPeselu.end()) continue;
+			it->second->dodajKonto(konto);
+			if (wlascicielKonta[konto->getIdKonta()] == nullptr) wlascicielKonta[konto->getIdKonta()] = it->second;
+		}
+
+		autoryzacja.rezerwuj(wszystkieKarty.getElementy().size());
+		kartyKonta.assign(liczbaNumerow, vector<Karta*>());
+		for (auto karta : wszystkieKarty)
+		{
+			if (auto kartaDebetowa = dynamic_cast<KartaDebetowa*>(karta))
 			{
-				if (konto->getWlasciciel() == klient.getPesel())
+				kartyKonta[kartaDebetowa->getIdPowiazanegoKonta()].push_back(karta);
+				if (!autoryzacja.dodaj(kartaDebetowa))
+				{
+					cerr << "Karta " << kartaDebetowa->getNumerKarty() << " ma niepoprawny lub powtorzony numer - platnosci nia nie beda autoryzowane." << endl;
+				}
+				if (Klient* wlasciciel = wlascicielKonta[kartaDebetowa->getIdPowiazanegoKonta()])
 				{
-					klient.dodajKonto(konto);
+					wlasciciel->dodajKarte(karta);
 				}
 			}
+		}
+
+		for (size_t i = 0; i < wszystkieLokaty.size(); i++)
+		{
+			const Lokata& lokata = wszystkieLokaty[i];
+			if (lokata.czyUsunieta()) continue;
+			if (Klient* wlasciciel = wlascicielKonta[lokata.getIdPowiazanegoKonta()])
+			{
+				wlasciciel->dodajLokate(static_cast<uint32_t>(i));
+			}
+		}
+		zbudujHarmonogramLokat();
+
+		transakcjeKonta.assign(liczbaNumerow, vector<uint32_t>());
+		for (size_t i = 0; i < transakcje.size(); i++)
+		{
+			const Transakcja& transakcja = transakcje[i];
+			if (transakcja.getIdNadawcy() != 0) transakcjeKonta[transakcja.getIdNadawcy()].push_back(static_cast<uint32_t>(i));
+			if (transakcja.getIdOdbiorcy() != transakcja.getIdNadawcy() && transakcja.getIdOdbiorcy() != 0)
+			{
+				transakcjeKonta[transakcja.getIdOdbiorcy()].push_back(static_cast<uint32_t>(i));
+			}
+		}
+		// Historia jest zwykle dopisywana chronologicznie, wiec sortowanie jest rzadko potrzebne
+		auto porzadek = [this](uint32_t a, uint32_t b) { return kluczHistorii(a) < kluczHistorii(b); };
+		for (auto& lista : transakcjeKonta)
+		{
+			if (!is_sorted(lista.begin(), lista.end(), porzadek))
+			{
+				sort(lista.begin(), lista.end(), porzadek);
+			}
+		}
+	}
+
+	/**
+	 * @brief Wyszukuje konto banku po numerze.
+	 *
+	 * Numer spoza slownika nie jest do niego dodawany, wiec bledne numery wpisane
+	 * przez uzytkownika nie powiekszaja indeksow.
+	 *
+	 * @param numer Numer konta
+	 * @return Wskaznik na konto lub nullptr, jesli konto nie nalezy do banku
+	 */
+	KontoGlowne* znajdzKontoPoNumerze(const string& numer) const
+	{
+		uint32_t id;
+		if (!SlownikNumerow::globalny().znajdz(numer, id) || id >= kontaPoId.size()) return nullptr;
+		return kontaPoId[id];
+	}
+
+	/**
+	 * @brief Dodaje konto do katalogu kontaPoId.
+	 *
+	 * @param konto Nowe konto
+	 */
+	void zarejestrujKonto(KontoGlowne* konto)
+	{
+		uint32_t id = konto->getIdKonta();
+		if (id >= kontaPoId.size()) kontaPoId.resize(id + 1, nullptr);
+		kontaPoId[id] = konto;
+	}
+
+	/**
+	 * @brief Dodaje karte debetowa do listy kart jej konta w kartyKonta.
+	 *
+	 * @param karta Nowa karta
+	 */
+	void zarejestrujKarte(KartaDebetowa* karta)
+	{
+		uint32_t id = karta->getIdPowiazanegoKonta();
+		if (id >= kartyKonta.size()) kartyKonta.resize(id + 1);
+		kartyKonta[id].push_back(karta);
+	}
+
+	/**
+	 * @brief Zwraca klucz porzadku historii: miesiac transakcji w starszych bitach, indeks w mlodszych.
+	 *
+	 * Klucz jest tez kursorem stronicowania - nie zmienia sie przy dopisywaniu nowych transakcji.
+	 *
+	 * @param indeks Indeks transakcji w wektorze transakcje
+	 */
+	uint64_t kluczHistorii(uint32_t indeks) const
+	{
+		return (static_cast<uint64_t>(transakcje[indeks].getMiesiacTransakcji()) << 32) | indeks;
+	}
+
+	/**
+	 * @brief Wstawia transakcje do listy konta z zachowaniem porzadku kluczHistorii.
+	 *
+	 * @param idKonta Identyfikator numeru konta
+	 * @param indeks Indeks transakcji w wektorze transakcje
+	 */
+	void dodajDoHistoriiKonta(uint32_t idKonta, uint32_t indeks)
+	{
+		if (idKonta >= transakcjeKonta.size()) transakcjeKonta.resize(idKonta + 1);
+		vector<uint32_t>& lista = transakcjeKonta[idKonta];
+		uint64_t klucz = kluczHistorii(indeks);
+		if (lista.empty() || kluczHistorii(lista.back()) < klucz)
+		{
+			lista.push_back(indeks); // Zwykly przypadek - najnowsza transakcja
+			return;
+		}
+		auto miejsce = upper_bound(lista.begin(), lista.end(), klucz,
+			[this](uint64_t k, uint32_t i) { return k < kluczHistorii(i); });
+		lista.insert(miejsce, indeks);
+	}
+
+	/**
+	 * @brief Dopisuje transakcje o podanym indeksie do list transakcji kont nadawcy i odbiorcy.
+	 *
+	 * Pusty numer (np. nadawca odsetek) nie ma listy.
+	 *
+	 * @param indeks Indeks transakcji w wektorze transakcje
+	 */
+	void zaindeksujTransakcje(size_t indeks)
+	{
+		const Transakcja& transakcja = transakcje[indeks];
+		if (transakcja.getIdNadawcy() != 0) dodajDoHistoriiKonta(transakcja.getIdNadawcy(), static_cast<uint32_t>(indeks));
+		if (transakcja.getIdOdbiorcy() != transakcja.getIdNadawcy() && transakcja.getIdOdbiorcy() != 0)
+		{
+			dodajDoHistoriiKonta(transakcja.getIdOdbiorcy(), static_cast<uint32_t>(indeks));
+		}
+	}
 
-			for (auto karta : wszystkieKarty)
+	/**
+	 * @brief Kapitalizuje odsetki wszystkich kont oszczednosciowych za podany miesiac.
+	 *
+	 * Wiersze MagazynKont sa dzielone na czesci, po jednej na watek. Pierwsze przejscie liczy
+	 * konta z niezerowymi odsetkami w kazdej czesci, dzieki czemu drugie przejscie dopisuje
+	 * odsetki do sald i zapisuje transakcje od razu na ich docelowych miejscach, bez blokad.
+	 * Konta z zerowymi odsetkami dostaja tylko nowa date kapitalizacji.
+	 *
+	 * @param miesiac Miesiac kapitalizacji RRRRMM
+	 * @param sumaOdsetek Suma naliczonych odsetek
+	 * @return Liczba transakcji odsetek dopisanych na koniec wektora transakcje
+	 */
+	size_t kapitalizujKontaOszczednosciowe(uint32_t miesiac, Pieniadze& sumaOdsetek)
+	{
+		const uint32_t PACZKA = 1024; // Odsetki paczki sa trzymane na stosie do zapisania transakcji
+		const size_t MINIMALNA_CZESC = 4096; // Mniejsze czesci nie zwracaja kosztu uruchomienia watku
+		MagazynKont& magazyn = MagazynKont::globalny();
+		const size_t liczbaWierszy = magazyn.size();
+		const size_t liczbaCzesci = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), (liczbaWierszy + MINIMALNA_CZESC - 1) / MINIMALNA_CZESC));
+		const size_t rozmiarCzesci = (liczbaWierszy + liczbaCzesci - 1) / liczbaCzesci;
+		auto poczatek = [&](size_t czesc) { return min(liczbaWierszy, czesc * rozmiarCzesci); };
+
+		vector<size_t> pozycjaCzesci(liczbaCzesci + 1, 0);
+		wykonajRownolegle(liczbaCzesci, [&](size_t od, size_t doCzesci)
+		{
+			for (size_t c = od; c < doCzesci; c++)
 			{
-				if (auto kartaDebetowa = dynamic_cast<KartaDebetowa*>(karta))
+				size_t liczba = 0;
+				magazyn.dlaWierszy(poczatek(c), poczatek(c + 1), [miesiac, &liczba](const MagazynKont::Blok& b, uint32_t p, uint32_t k)
 				{
-					for (auto kontoKlienta : klient.getKontaUzytkownika())
+					size_t n = 0;
+					for (uint32_t i = p; i < k; i++)
 					{
-						if (kartaDebetowa->getPowiazaneKonto() == kontoKlienta->getNumerKonta())
-						{
-							klient.dodajKarte(karta);
-							break; // Zatrzymujemy petle, gdy znajdziemy powiazanie
-						}
+						n += MagazynKont::czyDoKapitalizacji(b, i, miesiac) & (MagazynKont::odsetkiMiesieczne(b.saldo[i].load(memory_order_relaxed), b.oprocentowanie[i]) != 0);
 					}
-				}
+					liczba += n;
+				});
+				pozycjaCzesci[c + 1] = liczba;
 			}
-
-			for (auto lokata : wszystkieLokaty)
+		}, 1);
+		for (size_t c = 0; c < liczbaCzesci; c++) pozycjaCzesci[c + 1] += pozycjaCzesci[c];
+
+		const size_t pierwsza = transakcje.size();
+		transakcje.resize(pierwsza + pozycjaCzesci.back());
+		const int64_t teraz = static_cast<int64_t>(time(nullptr));
+		vector<int64_t> sumaCzesci(liczbaCzesci, 0);
+		wykonajRownolegle(liczbaCzesci, [&](size_t od, size_t doCzesci)
+		{
+			for (size_t c = od; c < doCzesci; c++)
 			{
-				for (auto kontoKlienta : klient.getKontaUzytkownika())
+				size_t pozycja = pierwsza + pozycjaCzesci[c];
+				int64_t suma = 0;
+				size_t wiersz = poczatek(c);
+				vector<uint32_t> noweZmiany;
+				magazyn.dlaWierszy(poczatek(c), poczatek(c + 1), [&](MagazynKont::Blok& b, uint32_t p, uint32_t k)
 				{
-					if (lokata.getPowiazaneKonto() == kontoKlienta->getNumerKonta())
+					int64_t odsetki[PACZKA];
+					uint8_t nowaZmiana[PACZKA];
+					const size_t pierwszyWiersz = wiersz - p;
+					for (uint32_t odPaczki = p; odPaczki < k; odPaczki += PACZKA)
 					{
-						klient.dodajLokate(lokata);
-						break; // Zatrzymujemy petle, gdy znajdziemy powiazanie
+						uint32_t doPaczki = min(k, odPaczki + PACZKA);
+						for (uint32_t i = odPaczki; i < doPaczki; i++)
+						{
+							bool kapitalizowac = MagazynKont::czyDoKapitalizacji(b, i, miesiac);
+							int64_t saldo = b.saldo[i].load(memory_order_relaxed);
+							int64_t o = kapitalizowac ? MagazynKont::odsetkiMiesieczne(saldo, b.oprocentowanie[i]) : 0;
+							odsetki[i - odPaczki] = o;
+							b.saldo[i].store(saldo + o, memory_order_relaxed); // Zadanie wsadowe - w trakcie nikt inny nie zmienia sald
+							b.miesiacKapitalizacji[i] = kapitalizowac ? miesiac : b.miesiacKapitalizacji[i];
+							uint8_t zmieniony = b.zmienione[i].load(memory_order_relaxed);
+							nowaZmiana[i - odPaczki] = static_cast<uint8_t>(kapitalizowac) & static_cast<uint8_t>(zmieniony ^ 1);
+							b.zmienione[i].store(zmieniony | static_cast<uint8_t>(kapitalizowac), memory_order_relaxed);
+						}
+						for (uint32_t i = odPaczki; i < doPaczki; i++)
+						{
+							if (nowaZmiana[i - odPaczki]) noweZmiany.push_back(static_cast<uint32_t>(pierwszyWiersz + i));
+							if (odsetki[i - odPaczki] == 0) continue;
+							Transakcja& t = transakcje[pozycja++];
+							t.setTypTransakcji(TypTransakcji::ODSETKI);
+							t.setKwota(Pieniadze::zGroszy(odsetki[i - odPaczki]));
+							t.setMiesiacTransakcji(miesiac);
+							t.setZnacznikCzasu(teraz);
+							t.setIdOdbiorcy(b.idKonta[i]);
+							suma += odsetki[i - odPaczki];
+						}
 					}
-				}
+					wiersz += k - p;
+				});
+				magazyn.dopiszZmienione(noweZmiany);
+				sumaCzesci[c] = suma;
 			}
-		}
+		}, 1);
+
+		int64_t suma = 0;
+		for (int64_t s : sumaCzesci) suma += s;
+		sumaOdsetek = Pieniadze::zGroszy(suma);
+		return transakcje.size() - pierwsza;
 	}
 
 	/**
-	* @brief Destruktor klasy SystemBankowy.
-	*
-	* Zwalnia pamięć zajmowaną przez wszystkie obiekty.
-	*/
-	~SystemBankowy()
+	 * @brief Dodaje nowa transakcje do historii banku i do indeksu transakcjeKonta.
+	 *
+	 * @param transakcja Transakcja do dodania
+	 */
+	void dodajTransakcje(const Transakcja& transakcja)
 	{
-		for (auto karta : wszystkieKarty)
+		transakcje.push_back(transakcja);
+		zaindeksujTransakcje(transakcje.size() - 1);
+	}
+
+	/**
+	 * @brief Dodaje lokate do harmonogramu wyplat wedlug miesiaca oddania.
+	 *
+	 * Rozliczone i usuniete lokaty oraz lokaty z niepoprawna data nie sa planowane.
+	 *
+	 * @param indeks Pozycja lokaty w wszystkieLokaty
+	 */
+	void zaplanujLokate(size_t indeks)
+	{
+		const Lokata& lokata = wszystkieLokaty[indeks];
+		if (lokata.czyRozliczona() || lokata.czyUsunieta() || lokata.getMiesiacOddania() == 0) return;
+		harmonogramLokat[lokata.getMiesiacOddania()].push_back(static_cast<uint32_t>(indeks));
+	}
+	/**
+	 * @brief Usuwa lokate z harmonogramu wyplat, np. po usunieciu jej razem z kontem.
+	 *
+	 * @param indeks Pozycja lokaty w wszystkieLokaty
+	 */
+	void odplanujLokate(uint32_t indeks)
+	{
+		auto miesiac = harmonogramLokat.find(wszystkieLokaty[indeks].getMiesiacOddania());
+		if (miesiac == harmonogramLokat.end()) return;
+		auto& indeksy = miesiac->second;
+		indeksy.erase(remove(indeksy.begin(), indeksy.end(), indeks), indeksy.end());
+		if (indeksy.empty()) harmonogramLokat.erase(miesiac);
+	}
+	/**
+	 * @brief Buduje harmonogram wyplat od nowa po wczytaniu danych.
+	 */
+	void zbudujHarmonogramLokat()
+	{
+		harmonogramLokat.clear();
+		for (size_t i = 0; i < wszystkieLokaty.size(); i++) zaplanujLokate(i);
+	}
+	/**
+	 * @brief Wyplaca lokaty, ktorych miesiac oddania juz minal.
+	 *
+	 * Harmonogram jest uporzadkowany wedlug miesiaca oddania, wiec odczytywane sa tylko
+	 * lokaty do wyplaty, a gdy zadna nie dojrzala, koszt to jedno porownanie.
+	 * Kwota lokaty z zyskiem trafia na powiazane konto jako wplata; wszystkie wyplaty
+	 * sa utrwalane jedna paczka zmian.
+	 *
+	 * @param suma Suma wyplaconych kwot
+	 * @return Liczba wyplaconych lokat
+	 */
+	size_t rozliczDojrzaleLokaty(Pieniadze& suma)
+	{
+		const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+		if (harmonogramLokat.empty() || harmonogramLokat.begin()->first >= miesiac) return 0;
+
+		json zmiany = json::array();
+		size_t liczba = 0;
+		const int64_t teraz = static_cast<int64_t>(time(nullptr));
+		auto koniec = harmonogramLokat.lower_bound(miesiac);
+		for (auto it = harmonogramLokat.begin(); it != koniec; ++it)
 		{
-			bool czyPowiazana = false;
-			for (auto& klient : klienci)
+			for (uint32_t indeks : it->second)
 			{
-				for (auto kartaKlienta : klient.getKartyUzytkownika())
-				{
-					if (kartaKlienta == karta)
-					{
-						czyPowiazana = true;
-						break;
-					}
-				}
-				if (czyPowiazana) break;
+				Lokata& lokata = wszystkieLokaty[indeks];
+				const uint32_t idKonta = lokata.getIdPowiazanegoKonta();
+				KontoGlowne* konto = idKonta < kontaPoId.size() ? kontaPoId[idKonta] : nullptr;
+				if (konto == nullptr || lokata.czyUsunieta()) continue; // Lokaty usunietych kont sa oznaczane razem z kontem
+
+				Pieniadze wyplata = lokata.getKwota() + lokata.obliczZysk();
+				lokata.setRozliczona(true);
+				menedzerPlikow.dodajRozliczenieLokaty(zmiany, indeks);
+				liczba++;
+				if (!wyplata.czyDodatnia()) continue; // Lokata bez wartosci (np. ujemne oprocentowanie) jest tylko zamykana
+
+				konto->uznaj(wyplata);
+				Transakcja transakcja;
+				transakcja.setTypTransakcji(TypTransakcji::WPLATA);
+				transakcja.setKwota(wyplata);
+				transakcja.setMiesiacTransakcji(miesiac);
+				transakcja.setZnacznikCzasu(teraz);
+				transakcja.setIdOdbiorcy(idKonta);
+				dodajTransakcje(transakcja);
+
+				menedzerPlikow.dodajOperacje(zmiany, *konto);
+				konto->oznaczZapisane();
+				suma += wyplata;
 			}
-			if (!czyPowiazana) delete karta; // Usuwamy karte
+		}
+		harmonogramLokat.erase(harmonogramLokat.begin(), koniec);
 
+		if (liczba > 0)
+		{
+			utrwalZmiany(zmiany);
+		}
+		return liczba;
+	}
+	/**
+	 * @brief Odswieza date operacji i wyplaca lokaty, ktorych termin wlasnie minal.
+	 */
+	void odswiezDate()
+	{
+		Kalendarz::globalny().odswiez();
+		Pieniadze wyplacone;
+		rozliczDojrzaleLokaty(wyplacone);
+	}
+public:
+	/**
+	 * @brief Konstruktor klasy SystemBankowy.
+	 *
+	 * Wczytuje dane klientów, transakcji, kart, kont i lokat z migawki binarnej
+	 * (lub z plików JSON, jeśli migawki nie ma) i odtwarza na nich dziennik.
+	 *
+	 * @throws Error jeśli migawka istnieje, ale jest uszkodzona - pliki JSON nie są
+	 * wtedy importowane, a migawka nie jest nadpisywana.
+	 */
+	SystemBankowy() : autoryzacja(kontaPoId), silnikPrzelewow(kontaPoId), zalogowanyKlient(nullptr), niezapisaneZmiany(false), zapisaneLokaty(0), zapisaneTransakcje(0)
+	{
+		auto poczatekWczytywania = chrono::steady_clock::now();
+		vector<Karta*> karty;
+		vector<KontoGlowne*> konta;
+		bool importZJson = !menedzerPlikow.wczytajMigawkeBinarna(klienci, transakcje, karty, wszystkieLokaty, konta);
+		if (importZJson)
+		{
+			// Brak migawki binarnej - import z plikow JSON, kazdy plik na osobnym watku
+			auto klienciZPliku = async(launch::async, [this] { return menedzerPlikow.wczytajKlientow(); });
+			auto transakcjeZPliku = async(launch::async, [this] { return menedzerPlikow.wczytajTransakcje(); });
+			auto kartyZPliku = async(launch::async, [this] { return menedzerPlikow.wczytajKarty(); });
+			auto lokatyZPliku = async(launch::async, [this] { return menedzerPlikow.wczytajLokaty(); });
+			auto kontaZPliku = async(launch::async, [this] { return menedzerPlikow.wczytajKonta(); });
+			klienci = klienciZPliku.get();
+			transakcje = transakcjeZPliku.get();
+			karty = kartyZPliku.get();
+			wszystkieLokaty = lokatyZPliku.get();
+			konta = kontaZPliku.get();
 		}
 
-		for (auto konto : wszystkieKonta)
+		menedzerPlikow.odtworzDziennik(klienci, transakcje, karty, wszystkieLokaty, konta);
+		wszystkieKarty.przejmij(move(karty));
+		wszystkieKonta.przejmij(move(konta));
+		if (menedzerPlikow.getLiczbaWpisowDziennika() > 0)
 		{
-			bool czyPowiazane = false;
-			for (auto& klient : klienci)
-			{
-				for (auto kontoKlienta : klient.getKontaUzytkownika())
-				{
-					if (kontoKlienta == konto)
-					{
-						czyPowiazane = true;
-						break;
-					}
-				}
-				if (czyPowiazane) break;
-			}
-			if (!czyPowiazane) delete konto; // Usuwamy konto
+			niezapisaneZmiany = true; // Pliki nie zawieraja zmian z dziennika
+		}
+		zapisaneLokaty = wszystkieLokaty.size();
+		zapisaneTransakcje = transakcje.size();
+		for (auto& klient : klienci) klient.oznaczZapisany();
+		MagazynKont::globalny().wyczyscZmienione();
+		for (auto karta : wszystkieKarty) karta->oznaczZapisana();
+
+		auto koniecWczytywania = chrono::steady_clock::now();
+		polaczDane();
+		czasLaczenia = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - koniecWczytywania);
+		czasWczytywania = chrono::duration_cast<chrono::microseconds>(koniecWczytywania - poczatekWczytywania);
+
+		if (importZJson && !klienci.empty())
+		{
+			niezapisaneZmiany = true;
+			punktKontrolny(); // Zaimportowane dane trafiaja od razu do migawki binarnej
 		}
 	}
+
 	/**
 	 * @brief Uruchamia system bankowy.
 	 *
@@ -2035,6 +5256,7 @@ public:
 				cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
 			} else {
 				cin.ignore(numeric_limits<streamsize>::max(), '\n');
+				odswiezDate(); // Cala operacja widzi date z chwili wyboru
 
 				switch (wybor) {
 					case 1:
@@ -2046,6 +5268,10 @@ public:
 						}
 						break;
 					case 0:
+						if (menedzerPlikow.getLiczbaWpisowDziennika() > 0)
+						{
+							punktKontrolny();
+						}
 						cout << "Koniec programu." << endl;
 						stop = true;
 						break;
@@ -2080,9 +5306,13 @@ public:
 		
 			
 
+			// Lokaty sa tylko oznaczane, zeby indeksy w dzienniku i harmonogramie pozostaly wazne
 			auto& lokaty = zalogowanyKlient->getLokatyUzytkownika();
 			for (auto it = lokaty.begin(); it != lokaty.end(); ) {
-				if (it->getPowiazaneKonto() == numer) {
+				Lokata& lokata = wszystkieLokaty[*it];
+				if (lokata.getPowiazaneKonto() == numer) {
+					odplanujLokate(*it);
+					lokata.setUsunieta(true);
 					it = lokaty.erase(it);
 				}
 				else {
@@ -2090,34 +5320,30 @@ public:
 				}
 			}
 
-			
-			auto& karty = zalogowanyKlient->getKartyUzytkownika();
-			for (auto it = karty.begin(); it != karty.end(); ) {
-				KartaDebetowa* karta = dynamic_cast<KartaDebetowa*>(*it);
-				if (karta && karta->getPowiazaneKonto() == numer) {
-					it = karty.erase(it);
-				}
-				else {
-					++it;
-				}
-			}
-
-
-			
-			for (auto it = wszystkieKonta.begin(); it != wszystkieKonta.end(); ++it) {
-				if ((*it)->getNumerKonta() == numer) {
-					wszystkieKonta.erase(it); 
-					break;
+			// Karty konta sa brane z kartyKonta, wiec usuwanie nie przechodzi po wszystkich kartach banku
+			KontoGlowne* konto = konta[wybor - 1];
+			const uint32_t idKonta = konto->getIdKonta();
+			if (idKonta < kartyKonta.size() && !kartyKonta[idKonta].empty()) {
+				auto& karty = zalogowanyKlient->getKartyUzytkownika();
+				karty.erase(remove_if(karty.begin(), karty.end(), [idKonta](Karta* karta) {
+					KartaDebetowa* debetowa = dynamic_cast<KartaDebetowa*>(karta);
+					return debetowa && debetowa->getIdPowiazanegoKonta() == idKonta;
+				}), karty.end());
+				for (auto karta : kartyKonta[idKonta])
+				{
+					autoryzacja.usun(karta);
+					wszystkieKarty.usun(karta);
 				}
-
+				kartyKonta[idKonta].clear();
 			}
 
 			if (zalogowanyKlient->usunKonto(numer)) {
-				cout << "Konto oraz powiązane karty i lokaty zostaly usuniete." << endl;
+				kontaPoId[konto->getIdKonta()] = nullptr;
+				wszystkieKonta.usun(konto);
 
-				menedzerPlikow.zapiszKonta(wszystkieKonta);
-				menedzerPlikow.zapiszKarty(zalogowanyKlient->getKartyUzytkownika());
-				menedzerPlikow.zapiszLokaty(zalogowanyKlient->getLokatyUzytkownika());
+				json zmiany = json::array();
+				menedzerPlikow.dodajUsuniecie(zmiany, "usun_konto", numer);
+				if (utrwalZmiany(zmiany)) cout << "Konto oraz powiązane karty i lokaty zostaly usuniete." << endl;
 			}
 			else {
 				cout << "Nie znaleziono konta." << endl;
@@ -2140,10 +5366,23 @@ public:
 		int wybor;
 		cin >> wybor;
 		if (wybor > 0 && wybor <= karty.size()) {
-			string numer = karty[wybor - 1]->getNumerKarty();
+			Karta* karta = karty[wybor - 1];
+			string numer = karta->getNumerKarty();
 			if (zalogowanyKlient->usunKarte(numer)) {
-				cout << "Karta zostala usunieta." << endl;
-				menedzerPlikow.zapiszKarty(zalogowanyKlient->getKartyUzytkownika());
+				if (KartaDebetowa* debetowa = dynamic_cast<KartaDebetowa*>(karta))
+				{
+					uint32_t idKonta = debetowa->getIdPowiazanegoKonta();
+					if (idKonta < kartyKonta.size())
+					{
+						auto& lista = kartyKonta[idKonta];
+						lista.erase(remove(lista.begin(), lista.end(), karta), lista.end());
+					}
+				}
+				autoryzacja.usun(karta);
+				wszystkieKarty.usun(karta);
+				json zmiany = json::array();
+				menedzerPlikow.dodajUsuniecie(zmiany, "usun_karte", numer);
+				if (utrwalZmiany(zmiany)) cout << "Karta zostala usunieta." << endl;
 			}
 			else {
 				cout << "Nie znaleziono karty." << endl;
@@ -2152,6 +5391,47 @@ public:
 	}
 
 	
+	/**
+	 * @brief Placi wybrana karta debetowa klienta.
+	 *
+	 * Platnosc przechodzi przez te sama autoryzacje co platnosci z terminali (PIN, waznosc,
+	 * dzienny limit, saldo), a zaakceptowana jest zapisywana w historii transakcji.
+	 */
+	void zaplacKarta()
+	{
+		auto& karty = zalogowanyKlient->getKartyUzytkownika();
+		if (karty.empty())
+		{
+			cout << "Nie masz zadnych kart." << endl;
+			return;
+		}
+		for (size_t i = 0; i < karty.size(); ++i) {
+			cout << i + 1 << ". " << karty[i]->getNumerKarty() << " (" << karty[i]->getTypKarty() << ")" << endl;
+		}
+		int wybor;
+		while (cout << "Wybierz karte: " && (!(cin >> wybor) || wybor < 1 || static_cast<size_t>(wybor) > karty.size())) {
+			cin.clear();
+			cin.ignore(numeric_limits<streamsize>::max(), '\n');
+			cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
+		}
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+		Pieniadze kwota;
+		while (cout << "Podaj kwote platnosci: " && !(cin >> kwota)) {
+			cin.clear();
+			cin.ignore(numeric_limits<streamsize>::max(), '\n');
+			cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
+		}
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+		string pin;
+		cout << "Podaj PIN: ";
+		cin >> pin;
+
+		WynikAutoryzacji wynik = autoryzujPlatnosc(karty[wybor - 1]->getNumerKarty(), pin, kwota);
+		cout << AutoryzacjaKart::opisWyniku(wynik) << "." << endl;
+	}
+
 	/**
 	 * @brief Wyświetla menu główne systemu bankowego.
 	 *
@@ -2185,6 +5465,7 @@ public:
 				cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
 			} else {
 				cin.ignore(numeric_limits<streamsize>::max(), '\n');
+				odswiezDate(); // Cala operacja widzi date z chwili wyboru
 
 				switch (wybor) {
 					case 1:
@@ -2200,7 +5481,7 @@ public:
 						zalogowanyKlient->wyswietlKarty();
 						break;
 					case 5:
-						zalogowanyKlient->wyswietlLokaty();
+						zalogowanyKlient->wyswietlLokaty(wszystkieLokaty);
 						break;
 					case 6:
 						dodajKonto();
@@ -2242,6 +5523,12 @@ public:
 					case 12:
 						usunKarte();
 						break;
+					case 13:
+						wyswietlWyciag();
+						break;
+					case 14:
+						zaplacKarta();
+						break;
 					case 0:
 						zalogowanyKlient = nullptr; // Wylogowanie
 						cout << "Wylogowano." << endl;
@@ -2286,101 +5573,426 @@ public:
 		{
 			cout << "12. Usun karte" << endl;
 		}
+		cout << "13. Wyciag z konta" << endl;
+		if (zalogowanyKlient->getKartyUzytkownika().size() > 0)
+		{
+			cout << "14. Zaplac karta" << endl;
+		}
 		cout << "0. Wyloguj" << endl;
 		cout << "Wybierz opcje: ";
 	}
 	/**
-	 * @brief Obsługuje proces rejestracji nowego klienta.
-	 *
-	 * Zbiera dane od użytkownika, tworzy noy obiekt Klient
-	 * i dodaje go do listy klientów banku.
+	 * @brief Obsługuje proces rejestracji nowego klienta.
+	 *
+	 * Zbiera dane od użytkownika, tworzy noy obiekt Klient
+	 * i dodaje go do listy klientów banku.
+	 */
+	void zarejestrujKlienta()
+	{
+		string imie, nazwisko, pesel, login, haslo;
+
+		cout << "===== REJESTRACJA =====" << endl;
+		cout << "Podaj imie (ESC aby anulowac): ";
+		char znak;
+		while (true)
+		{
+			znak = _getch();
+			if (znak == 27)//ESC
+			{
+				cout << "Rejestracja anulowana.\n";
+				return;
+			} else if (znak =='\r')//Enter
+			{
+				cout << endl;
+				break;
+			} else
+			{
+				imie += znak;
+				cout << znak;
+			}
+		}
+		cout << "Podaj nazwisko: ";
+		cin >> nazwisko;
+		cout << "Podaj PESEL: ";
+		cin >> pesel;
+		cout << "Podaj login: ";
+		cin >> login;
+		cout << "Podaj haslo: ";
+		cin >> haslo;
+
+		if (sprawdzCzyLoginIstnieje(login))
+		{
+			cout << "Login jest juz zajety. Wybierz inny." << endl;
+			return;
+		}
+		if (klientPoPeselu.count(pesel) > 0)
+		{
+			cout << "Klient o tym numerze PESEL jest juz zarejestrowany." << endl;
+			return;
+		}
+
+		klienci.emplace_back(imie, nazwisko, pesel, login, haslo);
+
+		zalogowanyKlient = &klienci.back(); // Ustawiamy wskaźnik na nowego klienta
+		klientPoLoginie.emplace(login, zalogowanyKlient);
+		klientPoPeselu.emplace(pesel, zalogowanyKlient);
+		if (!utrwalZmiany()) return; // Zapisujemy zmiany do pliku
+		cout << "Rejestracja zakonczona sukcesem!" << endl;
+	}
+	/**
+	 * @brief Obsługuje proces logowania klienta.
+	 *
+	 * Sprawdza poprawność podanych danych logowania i
+	 * ustawia wskaźnik zalogowanegoKlienta.
+	 *
+	 * @return true jeśli logowanie powiodło się, false w przeciwnym razie
+	 */
+	bool zalogujKlienta()
+	{
+		string login, haslo;
+		cout << "===== LOGOWANIE =====" << endl;
+		cout << "Podaj login: ";
+		cin >> login;
+		cout << "Podaj haslo: ";
+		cin >> haslo;
+
+		auto it = klientPoLoginie.find(login);
+		if (it != klientPoLoginie.end() && it->second->getHaslo() == haslo)
+		{
+			zalogowanyKlient = it->second;
+			cout << "Logowanie zakonczone sukcesem!" << endl;
+			return true;
+		}
+
+		cout << "Niepoprawny login lub haslo." << endl;
+		return false;
+	}
+
+	/**
+	 * @brief Zapisywanie (edytowanych) danych klientów do pliku.
+	 * 
+	 * Zapisywane sa tylko faktycznie zmienione dane - np. zmiana imienia nie zapisuje kont.
+	 */
+	bool zapiszDaneKlientow()
+	{
+		return utrwalZmiany();
+	}
+	/**
+	 * @brief Utrwala zmiany wprowadzone przez biezaca operacje.
+	 *
+	 * Do paczki trafiaja tylko oznaczone jako zmienione dane zalogowanego klienta i jego karty,
+	 * wszystkie konta oznaczone w kolumnie zmian MagazynKont oraz lokaty i transakcje dopisane
+	 * od ostatniego zapisu, wiec ilosc zapisywanych danych zalezy od wielkosci zmiany, a nie
+	 * od wielkosci bazy. Paczka jest dopisywana jako jeden wiersz dziennika.
+	 *
+	 * Jesli zapis do dziennika sie nie uda, zmiany sa utrwalane pelnym punktem kontrolnym;
+	 * gdy i to zawiedzie, uzytkownik dostaje komunikat, ze operacja nie zostala zapisana.
+	 *
+	 * @param zmiany Operacje przygotowane przez wywolujacego, np. usuniecia z FileManager::dodajUsuniecie
+	 * @return true jesli zmiany sa utrwalone (w dzienniku lub w migawce)
+	 */
+	bool utrwalZmiany(json zmiany = json::array())
+	{
+		if (zalogowanyKlient != nullptr)
+		{
+			if (zalogowanyKlient->czyZmieniony())
+			{
+				menedzerPlikow.dodajOperacje(zmiany, *zalogowanyKlient);
+				zalogowanyKlient->oznaczZapisany();
+			}
+			for (auto karta : zalogowanyKlient->getKartyUzytkownika())
+			{
+				if (!karta->czyZmieniona()) continue;
+				menedzerPlikow.dodajOperacje(zmiany, *karta);
+				karta->oznaczZapisana();
+			}
+		}
+		dodajZmienioneKonta(zmiany);
+		for (; zapisaneLokaty < wszystkieLokaty.size(); zapisaneLokaty++)
+		{
+			menedzerPlikow.dodajOperacje(zmiany, wszystkieLokaty[zapisaneLokaty], zapisaneLokaty);
+		}
+		for (; zapisaneTransakcje < transakcje.size(); zapisaneTransakcje++)
+		{
+			menedzerPlikow.dodajOperacje(zmiany, transakcje[zapisaneTransakcje], zapisaneTransakcje);
+		}
+
+		if (zmiany.empty()) return true;
+		niezapisaneZmiany = true;
+
+		if (!menedzerPlikow.zapiszDoDziennika(zmiany))
+		{
+			if (punktKontrolny()) return true; // Migawka zawiera zmiany, a dziennik zostal wyczyszczony
+
+			cout << "Blad zapisu danych na dysk - operacja nie zostala utrwalona i moze zostac utracona." << endl;
+			return false;
+		}
+		if (menedzerPlikow.getLiczbaWpisowDziennika() >= PROG_PUNKTU_KONTROLNEGO)
+		{
+			punktKontrolny();
+		}
+		return true;
+	}
+	/**
+	 * @brief Dopisuje do paczki zmian wszystkie konta oznaczone w MagazynKont jako zmienione.
+	 *
+	 * Lista zmian MagazynKont obejmuje tez konta innych klientow (np. odbiorcow przelewow),
+	 * a koszt zalezy tylko od liczby zmienionych kont. Wiersze kont spoza katalogu banku
+	 * sa zdejmowane z listy bez zapisu.
+	 *
+	 * @param zmiany Tablica JSON z operacjami jednej zmiany
+	 */
+	void dodajZmienioneKonta(json& zmiany)
+	{
+		MagazynKont& magazyn = MagazynKont::globalny();
+		magazyn.oproznijZmienione([&](uint32_t wiersz)
+		{
+			uint32_t idKonta = magazyn.blok(wiersz).idKonta[MagazynKont::pozycja(wiersz)];
+			KontoGlowne* konto = idKonta < kontaPoId.size() ? kontaPoId[idKonta] : nullptr;
+			if (konto != nullptr) menedzerPlikow.dodajOperacje(zmiany, *konto);
+		});
+	}
+	/**
+	 * @brief Zapisuje migawke binarna i czysci dziennik.
+	 *
+	 * Migawka jest zapisywana w calosci (jednym plikiem), ale tylko gdy cokolwiek sie zmienilo. Dziennik jest
+	 * czyszczony dopiero po zapisaniu migawki, wiec przerwany punkt kontrolny zostanie powtorzony
+	 * przy nastepnym uruchomieniu. Po udanym zapisie kasowane sa znaczniki zmian kont w MagazynKont.
+	 *
+	 * @return true jesli dane sa zapisane w migawce, false jesli zapis sie nie udal
+	 */
+	bool punktKontrolny()
+	{
+		if (niezapisaneZmiany)
+		{
+			if (!menedzerPlikow.zapiszMigawkeBinarna(klienci, transakcje, wszystkieKarty.getElementy(), wszystkieLokaty, wszystkieKonta.getElementy()))
+			{
+				return false; // Dziennik zostaje, dane nie zostana utracone
+			}
+		}
+		niezapisaneZmiany = false;
+		menedzerPlikow.wyczyscDziennik();
+		MagazynKont::globalny().wyczyscZmienione();
+		return true;
+	}
+	/**
+	 * @brief Utrwala wynik operacji wsadowej (kapitalizacji, paczki przelewow) punktem kontrolnym.
+	 *
+	 * Nowe transakcje sa uznawane za zapisane dopiero po udanym punkcie kontrolnym. Jesli
+	 * zapis sie nie uda, zmienione konta i nowe transakcje trafiaja do dziennika, zeby nie
+	 * zostaly utracone do czasu nastepnego punktu kontrolnego.
+	 */
+	void utrwalWynikWsadowy()
+	{
+		niezapisaneZmiany = true;
+		if (punktKontrolny())
+		{
+			zapisaneTransakcje = transakcje.size();
+			return;
+		}
+
+		if (utrwalZmiany()) // Zmienione konta z MagazynKont i nowe transakcje
+		{
+			cerr << "Nie udalo sie zapisac punktu kontrolnego - zmiany zapisano w dzienniku." << endl;
+		}
+	}
+	/**
+	 * @brief Wyswietla czasy poszczegolnych etapow uruchomienia systemu.
 	 */
-	void zarejestrujKlienta()
+	void wyswietlCzasyUruchomienia() const
 	{
-		string imie, nazwisko, pesel, login, haslo;
+		cout << "Wczytywanie danych: " << czasWczytywania.count() / 1000.0 << " ms" << endl;
+		cout << "Laczenie danych i budowa indeksow: " << czasLaczenia.count() / 1000.0 << " ms" << endl;
 
-		cout << "===== REJESTRACJA =====" << endl;
-		cout << "Podaj imie (ESC aby anulowac): ";
-		char znak;
-		while (true)
+		auto poczatekSumy = chrono::steady_clock::now();
+		Pieniadze suma = MagazynKont::globalny().sumaSald();
+		auto czasSumy = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatekSumy);
+		cout << "Suma sald wszystkich kont: " << suma << " PLN (" << czasSumy.count() / 1000.0 << " ms)" << endl;
+	}
+	/**
+	 * @brief Wykonuje kapitalizacje odsetek wszystkich kont oszczednosciowych na koniec miesiaca.
+	 *
+	 * Kapitalizowane sa konta, ktorych ostatnia kapitalizacja byla przed biezacym miesiacem.
+	 * Transakcje odsetek nie trafiaja do dziennika - zmiany sa utrwalane jednym punktem kontrolnym
+	 * (do dziennika tylko wtedy, gdy punkt kontrolny sie nie uda).
+	 */
+	void kapitalizacjaMiesieczna()
+	{
+		auto poczatekKapitalizacji = chrono::steady_clock::now();
+		Kalendarz::globalny().odswiez();
+		uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+
+		Pieniadze sumaOdsetek;
+		size_t pierwsza = transakcje.size();
+		size_t liczba = kapitalizujKontaOszczednosciowe(miesiac, sumaOdsetek);
+		for (size_t i = pierwsza; i < transakcje.size(); i++) zaindeksujTransakcje(i);
+		utrwalWynikWsadowy();
+
+		auto czas = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatekKapitalizacji);
+		cout << "Kapitalizacja za " << setw(2) << setfill('0') << miesiac % 100 << setfill(' ') << "/" << miesiac / 100
+			<< ": naliczono odsetki na " << liczba << " kontach, razem " << sumaOdsetek << " PLN ("
+			<< czas.count() / 1000.0 << " ms)" << endl;
+	}
+	/**
+	 * @brief Autoryzuje platnosc karta debetowa i utrwala jej skutki.
+	 *
+	 * Zaakceptowana platnosc trafia do historii jako wyplata z powiazanego konta,
+	 * a zmienione konto i karta sa zapisywane jedna paczka zmian.
+	 *
+	 * @param numerKarty Numer karty
+	 * @param pin PIN podany przy platnosci
+	 * @param kwota Kwota platnosci
+	 * @return Wynik autoryzacji
+	 */
+	WynikAutoryzacji autoryzujPlatnosc(const string& numerKarty, const string& pin, Pieniadze kwota)
+	{
+		KartaDebetowa* karta = nullptr;
+		WynikAutoryzacji wynik = autoryzacja.autoryzuj(numerKarty, pin, kwota, &karta);
+		if (wynik != WynikAutoryzacji::ZAAKCEPTOWANA) return wynik;
+
+		KontoGlowne* konto = kontaPoId[karta->getIdPowiazanegoKonta()];
+
+		Transakcja transakcja;
+		transakcja.setTypTransakcji(TypTransakcji::WYPLATA);
+		transakcja.setKwota(kwota);
+		transakcja.setMiesiacTransakcji(Kalendarz::globalny().getMiesiac());
+		transakcja.setZnacznikCzasu(static_cast<int64_t>(time(nullptr)));
+		transakcja.setIdNadawcy(karta->getIdPowiazanegoKonta());
+		dodajTransakcje(transakcja);
+
+		json zmiany = json::array();
+		menedzerPlikow.dodajOperacje(zmiany, *konto);
+		konto->oznaczZapisane();
+		menedzerPlikow.dodajOperacje(zmiany, *karta);
+		karta->oznaczZapisana();
+		utrwalZmiany(zmiany);
+		return wynik;
+	}
+	/**
+	 * @brief Wykonuje paczke przelewow miedzy kontami banku na wielu watkach.
+	 *
+	 * Transakcje wykonanych przelewow sa dopisywane w kolejnosci zlecen, a zmiany sa
+	 * utrwalane jednym punktem kontrolnym, tak jak przy kapitalizacji.
+	 *
+	 * @param zlecenia Przelewy do wykonania
+	 * @return Wynik kazdego zlecenia
+	 */
+	vector<WynikPrzelewu> wykonajPrzelewy(const vector<ZleceniePrzelewu>& zlecenia)
+	{
+		vector<WynikPrzelewu> wyniki(zlecenia.size());
+		wykonajRownolegle(zlecenia.size(), [&](size_t od, size_t doZlecenia)
 		{
-			znak = _getch();
-			if (znak == 27)//ESC
-			{
-				cout << "Rejestracja anulowana.\n";
-				return;
-			} else if (znak =='\r')//Enter
-			{
-				cout << endl;
-				break;
-			} else
-			{
-				imie += znak;
-				cout << znak;
-			}
-		}
-		cout << "Podaj nazwisko: ";
-		cin >> nazwisko;
-		cout << "Podaj PESEL: ";
-		cin >> pesel;
-		cout << "Podaj login: ";
-		cin >> login;
-		cout << "Podaj haslo: ";
-		cin >> haslo;
+			for (size_t i = od; i < doZlecenia; i++) wyniki[i] = silnikPrzelewow.przelej(zlecenia[i]);
+		});
 
-		if (sprawdzCzyLoginIstnieje(login))
+		const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+		const int64_t teraz = static_cast<int64_t>(time(nullptr));
+		for (size_t i = 0; i < zlecenia.size(); i++)
 		{
-			cout << "Login jest juz zajety. Wybierz inny." << endl;
-			return;
+			if (wyniki[i] != WynikPrzelewu::WYKONANY) continue;
+			Transakcja transakcja;
+			transakcja.setTypTransakcji(TypTransakcji::PRZELEW);
+			transakcja.setKwota(zlecenia[i].kwota);
+			transakcja.setMiesiacTransakcji(miesiac);
+			transakcja.setZnacznikCzasu(teraz);
+			transakcja.setIdNadawcy(zlecenia[i].nadawca);
+			transakcja.setIdOdbiorcy(zlecenia[i].odbiorca);
+			dodajTransakcje(transakcja);
 		}
 
-		Klient nowyKlient(imie, nazwisko, pesel, login, haslo);
-		klienci.push_back(nowyKlient);
-		menedzerPlikow.zapiszKlientow(klienci); // Zapisujemy zmiany do pliku
+		utrwalWynikWsadowy();
+		return wyniki;
+	}
+	/**
+	 * @brief Wyplaca wszystkie lokaty, ktorych termin minal, i wyswietla podsumowanie.
+	 */
+	void rozliczenieLokat()
+	{
+		auto poczatekRozliczenia = chrono::steady_clock::now();
+		Kalendarz::globalny().odswiez();
+
+		Pieniadze suma;
+		size_t liczba = rozliczDojrzaleLokaty(suma);
 
-		zalogowanyKlient = &klienci.back(); // Ustawiamy wskaźnik na nowego klienta
-		cout << "Rejestracja zakonczona sukcesem!" << endl;
+		auto czas = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatekRozliczenia);
+		cout << "Rozliczenie lokat: wyplacono " << liczba << " lokat, razem " << suma << " PLN ("
+			<< czas.count() / 1000.0 << " ms)" << endl;
 	}
 	/**
-	 * @brief Obsługuje proces logowania klienta.
+	 * @brief Wykonuje paczke przelewow z pliku tekstowego i wyswietla podsumowanie.
 	 *
-	 * Sprawdza poprawność podanych danych logowania i
-	 * ustawia wskaźnik zalogowanegoKlienta.
+	 * Kazdy wiersz pliku zawiera numer konta nadawcy, numer konta odbiorcy i kwote,
+	 * oddzielone odstepami. Przelewy sa wykonywane rownolegle przez wykonajPrzelewy.
 	 *
-	 * @return true jeśli logowanie powiodło się, false w przeciwnym razie
+	 * @param nazwa Nazwa pliku ze zleceniami
 	 */
-	bool zalogujKlienta()
+	void przelewyZPliku(const string& nazwa)
 	{
-		string login, haslo;
-		cout << "===== LOGOWANIE =====" << endl;
-		cout << "Podaj login: ";
-		cin >> login;
-		cout << "Podaj haslo: ";
-		cin >> haslo;
+		ifstream plik(nazwa);
+		if (!plik.is_open())
+		{
+			cerr << "Nie mozna otworzyc pliku " << nazwa << "." << endl;
+			return;
+		}
+		Kalendarz::globalny().odswiez();
 
-		for (auto& klient : klienci)
+		const SlownikNumerow& slownik = SlownikNumerow::globalny();
+		vector<ZleceniePrzelewu> zlecenia;
+		string wiersz;
+		size_t numerWiersza = 0;
+		while (getline(plik, wiersz))
 		{
-			if (klient.getLogin() == login && klient.getHaslo() == haslo)
+			numerWiersza++;
+			istringstream pola(wiersz);
+			string nadawca, odbiorca;
+			ZleceniePrzelewu zlecenie;
+			if (!(pola >> nadawca)) continue; // Pusty wiersz
+			if (!(pola >> odbiorca >> zlecenie.kwota))
 			{
-				zalogowanyKlient = &klient;
-				cout << "Logowanie zakonczone sukcesem!" << endl;
-				return true;
+				cerr << "Pominieto niepoprawny wiersz " << numerWiersza << "." << endl;
+				continue;
 			}
+			// Nieznany numer dostaje identyfikator pustego numeru, ktory nie ma konta
+			if (!slownik.znajdz(nadawca, zlecenie.nadawca)) zlecenie.nadawca = 0;
+			if (!slownik.znajdz(odbiorca, zlecenie.odbiorca)) zlecenie.odbiorca = 0;
+			zlecenia.push_back(zlecenie);
 		}
 
-		cout << "Niepoprawny login lub haslo." << endl;
-		return false;
-	}
+		auto poczatek = chrono::steady_clock::now();
+		vector<WynikPrzelewu> wyniki = wykonajPrzelewy(zlecenia);
+		auto czas = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatek);
 
+		size_t liczniki[static_cast<size_t>(WynikPrzelewu::ODRZUCONY) + 1] = {};
+		for (WynikPrzelewu wynik : wyniki) liczniki[static_cast<size_t>(wynik)]++;
+		cout << "Przelewy z pliku " << nazwa << ": " << zlecenia.size() << " zlecen (" << czas.count() / 1000.0 << " ms)" << endl;
+		for (size_t w = 0; w <= static_cast<size_t>(WynikPrzelewu::ODRZUCONY); w++)
+		{
+			if (liczniki[w] > 0) cout << "  " << SilnikPrzelewow::opisWyniku(static_cast<WynikPrzelewu>(w)) << ": " << liczniki[w] << endl;
+		}
+	}
 	/**
-	 * @brief Zapisywanie (edytowanych) danych klientów do pliku.
-	 * 
-	 * 
+	 * @brief Ustala tryb trwalosci zapisow.
+	 *
+	 * @param tryb SYNCHRONICZNY (fsync po kazdej operacji), GRUPOWY (wspolny fsync dla operacji
+	 * z jednego okna) lub ASYNCHRONICZNY (bez czekania na fsync)
+	 * @param okno Okno grupowania zapisow
 	 */
-	void zapiszDaneKlientow()
+	void ustawTrwalosc(TrybTrwalosci tryb, chrono::milliseconds okno = chrono::milliseconds(5))
 	{
-		menedzerPlikow.zapiszKlientow(klienci); // Zapisujemy zmiany do pliku
-		menedzerPlikow.zapiszKonta(wszystkieKonta); // Zapisujemy konta
+		menedzerPlikow.setTrybTrwalosci(tryb, okno);
+	}
+	/**
+	 * @brief Zapisuje wszystkie dane do plikow JSON.
+	 *
+	 * Pliki JSON sluza tylko do eksportu danych (punkty kontrolne zapisuja migawke binarna).
+	 */
+	void eksportujDoJson()
+	{
+		menedzerPlikow.zapiszKlientow(klienci);
+		menedzerPlikow.zapiszKonta(wszystkieKonta.getElementy());
+		menedzerPlikow.zapiszKarty(wszystkieKarty.getElementy());
+		menedzerPlikow.zapiszLokaty(wszystkieLokaty);
+		menedzerPlikow.zapiszTransakcje(transakcje);
 	}
 	/**
 	 * @brief Dodaje nowe konto dla zalogowanego klienta.
@@ -2391,7 +6003,10 @@ public:
 	void dodajKonto()
 	{
 
-		string numerKonta = to_string(rand() % 1000000000 + 1); //
+		string numerKonta;
+		do {
+			numerKonta = to_string(rand() % 1000000000 + 1);
+		} while (znajdzKontoPoNumerze(numerKonta) != nullptr); // Numer musi byc unikalny w calym banku
 
 		cout << "===== DODAWANIE KONTO =====" << endl;
 		cout << "Wybierz typ konta:" << endl;
@@ -2406,7 +6021,7 @@ public:
 		}
 		cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-		float saldo;
+		Pieniadze saldo;
 		while (cout << "Podaj saldo poczatkowe: " && !(cin >> saldo)) {
 			cin.clear();
 			cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -2419,7 +6034,8 @@ public:
 			KontoGlowne* noweKonto = new KontoGlowne(numerKonta, "Glowne", saldo);
 			noweKonto->setWlascicielel(zalogowanyKlient->getPesel());
 			zalogowanyKlient->dodajKonto(noweKonto);
-			wszystkieKonta.push_back(noweKonto);
+			wszystkieKonta.dodaj(noweKonto);
+			zarejestrujKonto(noweKonto);
 		}
 		else if (typ == 2)
 		{
@@ -2439,21 +6055,15 @@ public:
 			}
 			cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-			time_t now = time(nullptr);
-			tm today;
-			localtime_s(&today, &now);
-
-			ostringstream oss;
-			oss << setw(2) << setfill('0') << (today.tm_mon + 1);
-			oss << setw(2) << setfill('0') << ((today.tm_year + 1900) % 100);
-			string dataKapitalizacji = oss.str();
-
-			KontoOszczednosciowe* noweKonto = new KontoOszczednosciowe(numerKonta, saldo, oprocentowanie, dataKapitalizacji, limit);
+			KontoOszczednosciowe* noweKonto = new KontoOszczednosciowe(numerKonta, saldo, oprocentowanie, "", limit);
+			noweKonto->setMiesiacKapitalizacji(Kalendarz::globalny().getMiesiac());
 			noweKonto->setWlascicielel(zalogowanyKlient->getPesel());
 			zalogowanyKlient->dodajKonto(noweKonto);
-			wszystkieKonta.push_back(noweKonto);
+			wszystkieKonta.dodaj(noweKonto);
+			zarejestrujKonto(noweKonto);
 		}
-		menedzerPlikow.zapiszKonta(wszystkieKonta); // Zapisujemy zmiany do pliku
+
+		if (!utrwalZmiany()) return; // Zapisujemy zmiany do pliku
 		cout << "Konto dodane pomyslnie!" << endl;
 	}
 	/**
@@ -2490,14 +6100,29 @@ public:
 		string powiazaneKonto = zalogowanyKlient->getKontaUzytkownika()[wyborKonta - 1]->getNumerKonta();
 		cout << "Podaj numer karty: (16 cyfr) ";
 		cin >> numerKarty;
+		if (AutoryzacjaKart::kluczKarty(numerKarty) == 0)
+		{
+			cout << "Niepoprawny numer karty. Numer moze zawierac tylko cyfry (najwyzej 18)." << endl;
+			return;
+		}
+		if (autoryzacja.znajdz(numerKarty) != nullptr)
+		{
+			cout << "Karta o tym numerze juz istnieje." << endl;
+			return;
+		}
 		cout << "Podaj date waznosci karty: (MMRR) ";
 		cin >> dataWaznosci;
+		if (Kalendarz::spakujMiesiac(dataWaznosci) == 0)
+		{
+			cout << "Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY" << endl;
+			return;
+		}
 		cout << "Podaj kod CVC: (3 cyfry) ";
 		cin >> cvc;
 		cout << "Podaj PIN: (4 cyfry) ";
 		cin >> pin;
 
-		float limit;
+		Pieniadze limit;
 		while (cout << "Podaj dzienny limit transakcji: " && !(cin >> limit)) {
 			cin.clear();
 			cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -2510,8 +6135,17 @@ public:
 			KartaDebetowa* nowaKarta = new KartaDebetowa(numerKarty, dataWaznosci, cvc,
 				powiazaneKonto, limit);
 			nowaKarta->setPin(pin);
+			if (!autoryzacja.dodaj(nowaKarta))
+			{
+				delete nowaKarta; // Karta, ktorej nie da sie autoryzowac, nie jest zapisywana
+				cout << "Nie udalo sie dodac karty do indeksu autoryzacji." << endl;
+				return;
+			}
 			zalogowanyKlient->dodajKarte(nowaKarta);
-			menedzerPlikow.zapiszKarty(zalogowanyKlient->getKartyUzytkownika()); // Zapisujemy zmiany do pliku
+			wszystkieKarty.dodaj(nowaKarta);
+			zarejestrujKarte(nowaKarta);
+
+			if (!utrwalZmiany()) return; // Zapisujemy zmiany do pliku
 
 			cout << "Karta dodana pomyslnie!" << endl;
 		} catch (const exception& e)
@@ -2550,13 +6184,18 @@ public:
 
 		KontoGlowne* wybraneKonto = zalogowanyKlient->getKontaUzytkownika()[wyborKonta - 1];
 
-		float kwota;
+		Pieniadze kwota;
 		while (cout << "Podaj kwote lokaty: " && !(cin >> kwota)) {
 			cin.clear();
 			cin.ignore(numeric_limits<streamsize>::max(), '\n');
 			cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
 		}
 		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+		if (!kwota.czyDodatnia())
+		{
+			cout << "Kwota lokaty musi byc wieksza od zera." << endl;
+			return;
+		}
 
 		float oprocentowanie;
 		while (cout << "Podaj oprocentowanie (%): " && !(cin >> oprocentowanie)) {
@@ -2569,6 +6208,11 @@ public:
 		string dataOddania;
 		cout << "Podaj date oddania lokaty: (MMRR) ";
 		cin >> dataOddania;
+		if (Kalendarz::spakujMiesiac(dataOddania) == 0)
+		{
+			cout << "Niepoprawny format daty. Oczekiwano formatu MMRR lub MM/YYYY" << endl;
+			return;
+		}
 
 		if (wybraneKonto->getSaldoKonta() < kwota)
 		{
@@ -2578,10 +6222,13 @@ public:
 
 		try
 		{
-			wybraneKonto->wyplac(kwota);
+			if (!wybraneKonto->wyplac(kwota)) return; // Komunikat wypisuje wyplac (np. limit wyplat)
 			Lokata nowaLokata(kwota, oprocentowanie, dataOddania, wybraneKonto->getNumerKonta());
-			zalogowanyKlient->dodajLokate(nowaLokata);
-			menedzerPlikow.zapiszLokaty(zalogowanyKlient->getLokatyUzytkownika()); // Zapisujemy zmiany do pliku
+			wszystkieLokaty.push_back(nowaLokata);
+			zalogowanyKlient->dodajLokate(static_cast<uint32_t>(wszystkieLokaty.size() - 1));
+			zaplanujLokate(wszystkieLokaty.size() - 1);
+
+			if (!utrwalZmiany()) return; // Zapisujemy zmiany do pliku
 
 			cout << "Lokata zalozona pomyslnie!" << endl;
 		}
@@ -2595,6 +6242,8 @@ public:
 	 *
 	 * Umożliwia zalogowanemu klientowi wykonanie przelewu
 	 * z jednego konta na drugie, tworząc odpowiedni rekord transakcji.
+	 * Konto docelowe jest wyszukiwane w katalogu kontaPoId; jeśli należy do banku,
+	 * zostaje uznane tą samą kwotą, a jego zmiana trafia do tej samej paczki zapisu co obciążenie nadawcy.
 	 */
 	void wykonajPrzelew()
 	{
@@ -2625,7 +6274,14 @@ public:
 		cout << "Podaj numer konta docelowego: ";
 		cin >> numerKontaDocelowego;
 
-		float kwota;
+		KontoGlowne* kontoDocelowe = znajdzKontoPoNumerze(numerKontaDocelowego);
+		if (kontoDocelowe == wybraneKonto)
+		{
+			cout << "Nie mozna wykonac przelewu na to samo konto." << endl;
+			return;
+		}
+
+		Pieniadze kwota;
 		while (cout << "Podaj kwote przelewu: " && !(cin >> kwota)) {
 			cin.clear();
 			cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -2634,21 +6290,24 @@ public:
 		cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
 		if (wybraneKonto->wyplac(kwota)) {
-			time_t now = time(nullptr);
-			tm today;
-			localtime_s(&today, &now);
-
-			ostringstream ss;
-			ss << put_time(&today, "%m/%Y");
+			json zmiany = json::array();
+			if (kontoDocelowe != nullptr)
+			{
+				kontoDocelowe->uznaj(kwota);
+				menedzerPlikow.dodajOperacje(zmiany, *kontoDocelowe); // Odbiorca moze byc kontem innego klienta
+				kontoDocelowe->oznaczZapisane();
+			}
 
 			Transakcja transakcja;
 			transakcja.setKwota(kwota);
-			transakcja.setDataTransakcji(ss.str());
+			transakcja.setMiesiacTransakcji(Kalendarz::globalny().getMiesiac());
 			transakcja.setTypTransakcji("przelew");
 			transakcja.setKontoNadawcy(wybraneKonto->getNumerKonta());
 			transakcja.setKontoOdbiorcy(numerKontaDocelowego);
-			transakcje.push_back(transakcja);
-			menedzerPlikow.zapiszTransakcje(transakcje); // Zapisujemy zmiany do pliku
+			transakcja.setZnacznikCzasu(static_cast<int64_t>(time(nullptr)));
+			dodajTransakcje(transakcja);
+
+			if (!utrwalZmiany(zmiany)) return; // Zapisujemy zmiany do pliku
 			cout << "Przelew wykonany pomyslnie!" << endl;
 		}
 
@@ -2662,27 +6321,143 @@ public:
 	void wyswietlHistorieTransakcji()
 	{
 		cout << "===== HISTORIA TRANSAKCJI =====" << endl;
-		bool znaleziono = false;
 
-		for (const auto& transakcja : transakcje)
+		// Laczymy listy transakcji kont klienta; przelew miedzy wlasnymi kontami jest na dwoch listach
+		vector<uint32_t> indeksy;
+		for (const auto& konto : zalogowanyKlient->getKontaUzytkownika())
 		{
-			for (const auto& konto : zalogowanyKlient->getKontaUzytkownika())
+			if (konto->getIdKonta() < transakcjeKonta.size())
 			{
-				if (transakcja.getKontoNadawcy() == konto->getNumerKonta() ||
-					transakcja.getKontoOdbiorcy() == konto->getNumerKonta())
-				{
-					transakcja.wyswietlSzczegolyTransakcji();
-					znaleziono = true;
-					break; // Przerywamy pętlę, jeśli znaleziono transakcję
-				}
-
+				const vector<uint32_t>& lista = transakcjeKonta[konto->getIdKonta()];
+				indeksy.insert(indeksy.end(), lista.begin(), lista.end());
 			}
 		}
-		if (!znaleziono)
+		sort(indeksy.begin(), indeksy.end()); // Kolejnosc dopisania, jak w pliku transakcji
+		indeksy.erase(unique(indeksy.begin(), indeksy.end()), indeksy.end());
+
+		for (uint32_t indeks : indeksy)
+		{
+			transakcje[indeks].wyswietlSzczegolyTransakcji();
+		}
+		if (indeksy.empty())
 		{
 			cout << "Brak transakcji do wyswietlenia." << endl;
 		}
 	}
+	/**
+	 * @struct StronaHistorii
+	 * @brief Wynik zapytania pobierzStroneHistorii.
+	 */
+	struct StronaHistorii
+	{
+		vector<const Transakcja*> transakcje; ///< Transakcje strony w kolejnosci dat
+		uint64_t nastepnyKursor = 0; ///< Kursor kolejnej strony (0 - brak kolejnej strony)
+	};
+	/**
+	 * @brief Zwraca jedna strone historii konta z podanego zakresu miesiecy.
+	 *
+	 * Poczatek zakresu jest wyszukiwany binarnie w liscie transakcji konta, wiec koszt zalezy
+	 * od rozmiaru strony, a nie od dlugosci historii. Transakcje bez poprawnej daty maja miesiac 0.
+	 *
+	 * @param numerKonta Numer konta
+	 * @param odMiesiaca Pierwszy miesiac zakresu (RRRRMM, np. Kalendarz::spakujMiesiac("0326"))
+	 * @param doMiesiaca Ostatni miesiac zakresu (RRRRMM), wlacznie
+	 * @param rozmiarStrony Maksymalna liczba transakcji na stronie
+	 * @param kursor 0 dla pierwszej strony lub nastepnyKursor poprzedniej strony
+	 * @return Strona historii
+	 */
+	StronaHistorii pobierzStroneHistorii(const string& numerKonta, uint32_t odMiesiaca, uint32_t doMiesiaca,
+		size_t rozmiarStrony, uint64_t kursor = 0) const
+	{
+		StronaHistorii strona;
+		uint32_t id;
+		if (!SlownikNumerow::globalny().znajdz(numerKonta, id) || id >= transakcjeKonta.size() || rozmiarStrony == 0) return strona;
+		const vector<uint32_t>& lista = transakcjeKonta[id];
+
+		uint64_t poczatek = max(static_cast<uint64_t>(odMiesiaca) << 32, kursor);
+		uint64_t koniec = (static_cast<uint64_t>(doMiesiaca) << 32) | 0xFFFFFFFFu;
+		auto pozycja = lower_bound(lista.begin(), lista.end(), poczatek,
+			[this](uint32_t i, uint64_t k) { return kluczHistorii(i) < k; });
+		for (; pozycja != lista.end() && kluczHistorii(*pozycja) <= koniec; ++pozycja)
+		{
+			if (strona.transakcje.size() == rozmiarStrony)
+			{
+				strona.nastepnyKursor = kluczHistorii(*pozycja);
+				break;
+			}
+			strona.transakcje.push_back(&transakcje[*pozycja]);
+		}
+		return strona;
+	}
+	/**
+	 * @brief Wyświetla wyciąg z wybranego konta za podany zakres miesięcy, strona po stronie.
+	 */
+	void wyswietlWyciag()
+	{
+		const size_t ROZMIAR_STRONY = 10;
+		auto& konta = zalogowanyKlient->getKontaUzytkownika();
+		if (konta.empty())
+		{
+			cout << "Nie masz zadnych kont." << endl;
+			return;
+		}
+
+		cout << "===== WYCIAG Z KONTA =====" << endl;
+		for (size_t i = 0; i < konta.size(); ++i)
+		{
+			cout << i + 1 << ". " << konta[i]->getNumerKonta() << endl;
+		}
+		int wyborKonta;
+		while (cout << "Wybierz opcje: " && (!(cin >> wyborKonta) || wyborKonta < 1 || static_cast<size_t>(wyborKonta) > konta.size())) {
+			cin.clear();
+			cin.ignore(numeric_limits<streamsize>::max(), '\n');
+			cout << "Niepoprawny wybor. Sprobuj ponownie." << endl;
+		}
+
+		string od, doDaty;
+		uint32_t odMiesiaca = 0, doMiesiaca = 0;
+		while (true) {
+			cout << "Podaj zakres miesiecy (MMRR MMRR): ";
+			if (!(cin >> od >> doDaty) ||
+				(odMiesiaca = Kalendarz::spakujMiesiac(od)) == 0 || (doMiesiaca = Kalendarz::spakujMiesiac(doDaty)) == 0) {
+				cin.clear();
+				cin.ignore(numeric_limits<streamsize>::max(), '\n');
+				cout << "Niepoprawna data. Sprobuj ponownie." << endl;
+				continue;
+			}
+			cin.ignore(numeric_limits<streamsize>::max(), '\n');
+			if (odMiesiaca > doMiesiaca) {
+				cout << "Poczatek zakresu nie moze byc pozniejszy niz jego koniec. Sprobuj ponownie." << endl;
+				continue;
+			}
+			break;
+		}
+
+		string numer = konta[wyborKonta - 1]->getNumerKonta();
+		uint64_t kursor = 0;
+		bool pierwsza = true;
+		do {
+			StronaHistorii strona = pobierzStroneHistorii(numer, odMiesiaca, doMiesiaca, ROZMIAR_STRONY, kursor);
+			if (pierwsza && strona.transakcje.empty())
+			{
+				cout << "Brak transakcji w podanym okresie." << endl;
+			}
+			for (auto transakcja : strona.transakcje)
+			{
+				transakcja->wyswietlSzczegolyTransakcji();
+			}
+			pierwsza = false;
+			kursor = strona.nastepnyKursor;
+			if (kursor != 0)
+			{
+				cout << "Wpisz 1, aby zobaczyc nastepna strone, lub 0, aby zakonczyc: ";
+				int dalej = 0;
+				if (!(cin >> dalej)) cin.clear();
+				cin.ignore(numeric_limits<streamsize>::max(), '\n');
+				if (dalej != 1) kursor = 0;
+			}
+		} while (kursor != 0);
+	}
 	/**
 	 * @brief Sprawdza, czy podany login jesy już zajęty.
 	 *
@@ -2694,14 +6469,33 @@ public:
 	 */
 	bool sprawdzCzyLoginIstnieje(const string& login)
 	{
-		for (const auto& klient : klienci)
+		return klientPoLoginie.count(login) > 0;
+	}
+	/**
+	 * @brief Zmienia PESEL klienta i przenosi go w indeksie klientPoPeselu.
+	 *
+	 * Konta klienta dostaja nowego wlasciciela, zeby rozliczenie lokat i laczenie danych
+	 * po ponownym uruchomieniu nadal trafialy do tego samego klienta.
+	 *
+	 * @param klient Klient, ktorego PESEL jest zmieniany
+	 * @param nowyPesel Nowy PESEL
+	 * @return false, jesli PESEL jest juz przypisany do innego klienta
+	 */
+	bool zmienPesel(Klient& klient, const string& nowyPesel)
+	{
+		string staryPesel = klient.getPesel();
+		if (nowyPesel == staryPesel) return true;
+		if (klientPoPeselu.count(nowyPesel) > 0) return false;
+
+		auto it = klientPoPeselu.find(staryPesel);
+		if (it != klientPoPeselu.end() && it->second == &klient) klientPoPeselu.erase(it);
+		klientPoPeselu.emplace(nowyPesel, &klient);
+		klient.setPesel(nowyPesel);
+		for (auto& konto : klient.getKontaUzytkownika())
 		{
-			if (klient.getLogin() == login)
-			{
-				return true;
-			}
+			konto->setWlascicielel(nowyPesel); // Aktualizujemy PESEL we wszystkich kontach
 		}
-		return false;
+		return true;
 	}
 };
 
@@ -2728,35 +6522,36 @@ void Klient:: edytujDane(SystemBankowy* systemBankowy) {
 	cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
 	string nowaWartosc;
+	string komunikat; // Potwierdzenie jest wypisywane dopiero po zapisaniu zmiany
 
 	switch (opcja) {
 	case 1:
 		cout << "Podaj nowe imie: ";
 		cin >> nowaWartosc;
 		setImie(nowaWartosc);
-		cout << "Imie zostalo zmienione." << endl;
+		komunikat = "Imie zostalo zmienione.";
 		break;
 	case 2:
 		cout << "Podaj nowe nazwisko: ";
 		cin >> nowaWartosc;
 		setNazwisko(nowaWartosc);
-		cout << "Nazwisko zostalo zmienione." << endl;
+		komunikat = "Nazwisko zostalo zmienione.";
 		break;
 	case 3:
 		cout << "Podaj nowy PESEL: ";
 		cin >> nowaWartosc;
-		setPesel(nowaWartosc);
-		for (auto& konto : kontaUzytkownika)
+		if (!systemBankowy || !systemBankowy->zmienPesel(*this, nowaWartosc))
 		{
-			konto->setWlascicielel(nowaWartosc); // Aktualizujemy PESEL we wszystkich kontach
+			cout << "Ten PESEL jest juz zarejestrowany." << endl;
+			return;
 		}
-		cout << "PESEL zostal zmieniony." << endl;
+		komunikat = "PESEL zostal zmieniony.";
 		break;
 	case 4:
 		cout << "Podaj nowe haslo: ";
 		cin >> nowaWartosc;
 		setHaslo(nowaWartosc);
-		cout << "Haslo zostalo zmienione." << endl;
+		komunikat = "Haslo zostalo zmienione.";
 		break;
 	case 0:
 		cout << "Powrot do menu." << endl;
@@ -2767,16 +6562,218 @@ void Klient:: edytujDane(SystemBankowy* systemBankowy) {
 
 	}
 
-	if (systemBankowy)
+	if (systemBankowy && !systemBankowy->zapiszDaneKlientow()) return;
+	if (!komunikat.empty()) cout << komunikat << endl;
+}
+/**
+ * @brief Mierzy przepustowosc autoryzacji platnosci kartami na jednym watku.
+ *
+ * Karty i konta testowe istnieja tylko w pamieci i nie sa zapisywane. Funkcja korzysta ze
+ * wspolnego slownika numerow i magazynu kont, wiec wolno ja wywolac tylko w procesie,
+ * ktory nie wczytal danych banku.
+ *
+ * @param liczbaKart Liczba kart (i kont) testowych
+ * @param liczbaAutoryzacji Liczba autoryzacji do wykonania
+ */
+void testAutoryzacji(size_t liczbaKart, size_t liczbaAutoryzacji)
+{
+	Kalendarz::globalny().odswiez();
+	vector<unique_ptr<KontoGlowne>> konta;
+	vector<unique_ptr<KartaDebetowa>> karty;
+	vector<string> numeryKart;
+	konta.reserve(liczbaKart);
+	karty.reserve(liczbaKart);
+	numeryKart.reserve(liczbaKart);
+	for (size_t i = 0; i < liczbaKart; i++)
+	{
+		string numerKonta = "T" + to_string(i);
+		konta.emplace_back(new KontoGlowne(numerKonta, "Glowne", Pieniadze::zZlotych(1000000)));
+		numeryKart.push_back(to_string(4000000000000000ull + i));
+		karty.emplace_back(new KartaDebetowa(numeryKart.back(), "12/2099", "123", numerKonta, Pieniadze::zZlotych(5000)));
+		karty.back()->setPin("1234");
+	}
+
+	vector<KontoGlowne*> kontaPoId(SlownikNumerow::globalny().size(), nullptr);
+	for (auto& konto : konta) kontaPoId[konto->getIdKonta()] = konto.get();
+	AutoryzacjaKart autoryzacja(kontaPoId);
+	autoryzacja.rezerwuj(liczbaKart);
+	for (auto& karta : karty) autoryzacja.dodaj(karta.get());
+
+	// Losowe karty i kwoty sa przygotowane wczesniej, zeby mierzyc tylko autoryzacje
+	vector<uint32_t> ktoraKarta(liczbaAutoryzacji);
+	vector<Pieniadze> kwoty(liczbaAutoryzacji);
+	uint64_t los = 88172645463325252ull;
+	for (size_t i = 0; i < liczbaAutoryzacji; i++)
+	{
+		los ^= los << 13; los ^= los >> 7; los ^= los << 17;
+		ktoraKarta[i] = static_cast<uint32_t>(los % liczbaKart);
+		kwoty[i] = Pieniadze::zGroszy(static_cast<int64_t>(los >> 40) % 20000 + 1);
+	}
+	const string pin = "1234";
+
+	size_t wyniki[static_cast<size_t>(WynikAutoryzacji::BRAK_SRODKOW) + 1] = {};
+	auto poczatek = chrono::steady_clock::now();
+	for (size_t i = 0; i < liczbaAutoryzacji; i++)
+	{
+		wyniki[static_cast<size_t>(autoryzacja.autoryzuj(numeryKart[ktoraKarta[i]], pin, kwoty[i]))]++;
+	}
+	auto czas = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatek);
+
+	double sekundy = max(czas.count(), static_cast<chrono::microseconds::rep>(1)) / 1e6;
+	cout << "Autoryzacje: " << liczbaAutoryzacji << " dla " << liczbaKart << " kart w " << czas.count() / 1000.0
+		<< " ms (" << static_cast<uint64_t>(liczbaAutoryzacji / sekundy) << " na sekunde)" << endl;
+	for (size_t w = 0; w <= static_cast<size_t>(WynikAutoryzacji::BRAK_SRODKOW); w++)
+	{
+		if (wyniki[w] > 0) cout << "  " << AutoryzacjaKart::opisWyniku(static_cast<WynikAutoryzacji>(w)) << ": " << wyniki[w] << endl;
+	}
+}
+/**
+ * @brief Mierzy przepustowosc SilnikPrzelewow przy rosnacej liczbie watkow.
+ *
+ * Przelewy sa losowe i rownomiernie rozlozone na konta. Konta testowe istnieja tylko
+ * w pamieci; po kazdym przebiegu sprawdzane jest, czy suma sald sie nie zmienila.
+ * Tak jak testAutoryzacji, wolno ja wywolac tylko przed wczytaniem danych banku.
+ *
+ * @param liczbaKont Liczba kont testowych
+ * @param liczbaPrzelewow Liczba przelewow w jednym przebiegu
+ */
+void testPrzelewow(size_t liczbaKont, size_t liczbaPrzelewow)
+{
+	Kalendarz::globalny().odswiez();
+	vector<unique_ptr<KontoGlowne>> konta;
+	konta.reserve(liczbaKont);
+	for (size_t i = 0; i < liczbaKont; i++)
+	{
+		konta.emplace_back(new KontoGlowne("T" + to_string(i), "Glowne", Pieniadze::zZlotych(1000)));
+	}
+	vector<KontoGlowne*> kontaPoId(SlownikNumerow::globalny().size(), nullptr);
+	vector<uint32_t> idKont;
+	for (auto& konto : konta)
+	{
+		kontaPoId[konto->getIdKonta()] = konto.get();
+		idKont.push_back(konto->getIdKonta());
+	}
+	SilnikPrzelewow silnik(kontaPoId);
+
+	vector<ZleceniePrzelewu> zlecenia(liczbaPrzelewow);
+	uint64_t los = 88172645463325252ull;
+	for (auto& zlecenie : zlecenia)
+	{
+		los ^= los << 13; los ^= los >> 7; los ^= los << 17;
+		zlecenie.nadawca = idKont[los % liczbaKont];
+		zlecenie.odbiorca = idKont[(los >> 24) % liczbaKont];
+		zlecenie.kwota = Pieniadze::zGroszy(static_cast<int64_t>(los >> 48) % 10000 + 1);
+	}
+
+	auto sumaSald = [&]
+	{
+		int64_t suma = 0;
+		for (auto& konto : konta) suma += konto->getSaldoKonta().getGrosze();
+		return suma;
+	};
+	const int64_t sumaPoczatkowa = sumaSald();
+	const size_t maksWatkow = max<size_t>(1, thread::hardware_concurrency());
+	double przepustowoscJednegoWatku = 0;
+	for (size_t watki = 1; watki <= maksWatkow; watki *= 2)
 	{
-		systemBankowy->zapiszDaneKlientow();
+		atomic<size_t> wykonane(0);
+		auto poczatek = chrono::steady_clock::now();
+		vector<thread> robotnicy;
+		for (size_t w = 0; w < watki; w++)
+		{
+			robotnicy.emplace_back([&, w]
+			{
+				size_t lokalnie = 0;
+				for (size_t i = w; i < liczbaPrzelewow; i += watki)
+				{
+					lokalnie += silnik.przelej(zlecenia[i]) == WynikPrzelewu::WYKONANY;
+				}
+				wykonane += lokalnie;
+			});
+		}
+		for (auto& robotnik : robotnicy) robotnik.join();
+		auto czas = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - poczatek);
+
+		double przepustowosc = liczbaPrzelewow / (max(czas.count(), static_cast<chrono::microseconds::rep>(1)) / 1e6);
+		if (watki == 1) przepustowoscJednegoWatku = przepustowosc;
+		cout << "Watki: " << watki << ", przelewy: " << liczbaPrzelewow << " (wykonane " << wykonane.load() << ") w "
+			<< czas.count() / 1000.0 << " ms, " << static_cast<uint64_t>(przepustowosc) << " na sekunde, przyspieszenie "
+			<< setprecision(2) << fixed << przepustowosc / przepustowoscJednegoWatku << endl;
+		if (sumaSald() != sumaPoczatkowa) cout << "BLAD: suma sald sie zmienila!" << endl;
 	}
 }
+#ifndef WIRTUALNY_BANK_TESTY // testy.cpp dolacza ten plik i ma wlasna funkcje main
 int main(int argc, char** argv) {
 
 	srand(static_cast<unsigned int>(time(nullptr)));
 
-	SystemBankowy system;
+	// Pomiary tworza konta testowe we wspolnym slowniku numerow i magazynie kont, wiec
+	// uruchamiane sa przed wczytaniem danych banku i nigdy nie trafiaja do jego plikow
+	for (int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		if (argument == "--test-autoryzacji")
+		{
+			testAutoryzacji(1000000, 10000000); // Pomiar autoryzacji kart bez uruchamiania menu
+			return 0;
+		}
+		else if (argument == "--test-przelewow")
+		{
+			testPrzelewow(1000000, 4000000); // Pomiar skalowania przelewow bez uruchamiania menu
+			return 0;
+		}
+	}
+
+	unique_ptr<SystemBankowy> bank;
+	try {
+		bank.reset(new SystemBankowy());
+	}
+	catch (const Error& e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
+	SystemBankowy& system = *bank;
+	for (int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		if (argument == "--eksportuj-json")
+		{
+			system.eksportujDoJson(); // Eksport danych do plikow JSON bez uruchamiania menu
+			return 0;
+		}
+		else if (argument == "--kapitalizacja")
+		{
+			system.kapitalizacjaMiesieczna(); // Kapitalizacja na koniec miesiaca bez uruchamiania menu
+			return 0;
+		}
+		else if (argument == "--rozliczenie-lokat")
+		{
+			system.rozliczenieLokat(); // Wyplata zakonczonych lokat bez uruchamiania menu
+			return 0;
+		}
+		else if (argument.compare(0, 11, "--przelewy=") == 0)
+		{
+			system.przelewyZPliku(argument.substr(11)); // Paczka przelewow z pliku bez uruchamiania menu
+			return 0;
+		}
+		else if (argument == "--czasy-uruchomienia")
+		{
+			system.wyswietlCzasyUruchomienia();
+		}
+		else if (argument == "--trwalosc=sync")
+		{
+			system.ustawTrwalosc(TrybTrwalosci::SYNCHRONICZNY);
+		}
+		else if (argument == "--trwalosc=grupowa")
+		{
+			system.ustawTrwalosc(TrybTrwalosci::GRUPOWY);
+		}
+		else if (argument == "--trwalosc=async")
+		{
+			system.ustawTrwalosc(TrybTrwalosci::ASYNCHRONICZNY);
+		}
+	}
 	system.uruchom();
 	return 0;
 }
+#endif
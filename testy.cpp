@@ -0,0 +1,485 @@
+/**
+ * @file testy.cpp
+ * @brief Testy systemu bankowego uruchamiane jako osobny program.
+ *
+ * Plik dolacza main.cpp bez jego funkcji main, wiec testy widza te same klasy co program.
+ * Testy zapisujace dane uzywaja plikow o nazwach testy*.json i testy.bin, ktore sa usuwane
+ * przed i po kazdym tescie, wiec nie dotykaja danych banku z biezacego katalogu.
+ * Program zwraca 0, jesli wszystkie sprawdzenia sie powiodly.
+ */
+#define WIRTUALNY_BANK_TESTY
+#include "main.cpp"
+
+namespace
+{
+	int liczbaSprawdzen = 0; ///< Liczba wykonanych sprawdzen
+	int liczbaBledow = 0; ///< Liczba niespelnionych sprawdzen
+
+	/**
+	 * @brief Zapisuje wynik sprawdzenia i wypisuje niespelniony warunek razem z wierszem pliku.
+	 */
+	void sprawdz(bool warunek, const char* opis, int wiersz)
+	{
+		liczbaSprawdzen++;
+		if (warunek) return;
+		liczbaBledow++;
+		cerr << "testy.cpp:" << wiersz << ": niespelniony warunek " << opis << endl;
+	}
+}
+
+#define SPRAWDZ(warunek) sprawdz((warunek), #warunek, __LINE__)
+
+/**
+ * @brief Parsuje kwote i zwraca ja w groszach (INT64_MIN, jesli tekst nie jest kwota).
+ */
+int64_t groszeZTekstu(const string& tekst)
+{
+	Pieniadze kwota;
+	return Pieniadze::parsuj(tekst, kwota) ? kwota.getGrosze() : INT64_MIN;
+}
+
+/**
+ * @brief Kwoty sa parsowane dokladnie, a zaokraglenia sa polowkami od zera.
+ */
+void testPieniedzy()
+{
+	SPRAWDZ(groszeZTekstu("123") == 12300);
+	SPRAWDZ(groszeZTekstu("123.4") == 12340);
+	SPRAWDZ(groszeZTekstu("123,45") == 12345);
+	SPRAWDZ(groszeZTekstu("-5.5") == -550);
+	SPRAWDZ(groszeZTekstu(".5") == 50);
+	SPRAWDZ(groszeZTekstu("0.10") == 10);
+	SPRAWDZ(groszeZTekstu("1.234") == INT64_MIN); // Ulamek grosza
+	SPRAWDZ(groszeZTekstu("") == INT64_MIN);
+	SPRAWDZ(groszeZTekstu("-") == INT64_MIN);
+	SPRAWDZ(groszeZTekstu(".") == INT64_MIN);
+	SPRAWDZ(groszeZTekstu("12a") == INT64_MIN);
+	SPRAWDZ(groszeZTekstu("1 000") == INT64_MIN);
+	SPRAWDZ(groszeZTekstu("99999999999999999999") == INT64_MIN); // Przepelnienie
+
+	// Dziesiec razy 0,10 zl to dokladnie 1 zl, czego nie zapewnia float
+	Pieniadze suma;
+	for (int i = 0; i < 10; i++) suma += Pieniadze::zZlotych(0.1);
+	SPRAWDZ(suma == Pieniadze::zZlotych(1));
+	SPRAWDZ(Pieniadze::zZlotych(0.1 + 0.2).getGrosze() == 30);
+	SPRAWDZ(Pieniadze::zZlotych(-12.345678).getGrosze() == -1235);
+
+	SPRAWDZ(Pieniadze::procentGroszy(1000, 5) == 50);
+	SPRAWDZ(Pieniadze::procentGroszy(50, 1) == 1); // 0,5 grosza w gore
+	SPRAWDZ(Pieniadze::procentGroszy(-50, 1) == -1); // i w dol dla ujemnych kwot
+	SPRAWDZ(Pieniadze::procentGroszy(149, 1) == 1);
+	SPRAWDZ(Pieniadze::procentGroszy(150, 1) == 2);
+	SPRAWDZ(Pieniadze::procentGroszy(120000, 6, 12) == 600);
+	SPRAWDZ(Pieniadze::zGroszy(120000).procent(6, 12) == Pieniadze::zGroszy(600));
+
+	SPRAWDZ(Pieniadze::zGroszy(123456).toString() == "1234.56");
+	SPRAWDZ(Pieniadze::zGroszy(-5).toString() == "-0.05");
+	SPRAWDZ(Pieniadze().toString() == "0.00");
+
+	Pieniadze wczytana;
+	istringstream poprawna("12,5");
+	SPRAWDZ(poprawna >> wczytana && wczytana.getGrosze() == 1250);
+	istringstream niepoprawna("1.999");
+	SPRAWDZ(!(niepoprawna >> wczytana));
+}
+
+/**
+ * @brief Usuwa pliki zapisywane przez FileManager("testy.json").
+ */
+void usunPlikiTestowe()
+{
+	const char* pliki[] = { "testy.json", "transakcje_testy.json", "karty_testy.json", "lokaty_testy.json",
+		"konta_testy.json", "dziennik_testy.json", "testy.bin", "testy.bin.tmp" };
+	for (const char* plik : pliki) remove(plik);
+}
+
+/**
+ * @brief Zwalnia konta i karty wczytane przez FileManager.
+ */
+void zwolnij(vector<KontoGlowne*>& konta, vector<Karta*>& karty)
+{
+	for (auto konto : konta) delete konto;
+	for (auto karta : karty) delete karta;
+	konta.clear();
+	karty.clear();
+}
+
+/**
+ * @brief Dziennik odtworzony dwa razy daje ten sam stan, a po przerwanym punkcie kontrolnym
+ * (nowa migawka, niewyczyszczony dziennik) wpisy zawarte w migawce nie sa stosowane ponownie.
+ */
+void testOdtwarzaniaDziennika()
+{
+	usunPlikiTestowe();
+	deque<Klient> klienci;
+	vector<Transakcja> transakcje;
+	vector<Karta*> karty;
+	vector<Lokata> lokaty;
+	vector<KontoGlowne*> konta;
+	{
+		// Punkt kontrolny, a po nim wplata zapisana tylko w dzienniku
+		FileManager pliki("testy.json");
+		pliki.setTrybTrwalosci(TrybTrwalosci::SYNCHRONICZNY, chrono::milliseconds(0));
+		konta.push_back(new KontoGlowne("T001", "Glowne", Pieniadze::zZlotych(100)));
+		SPRAWDZ(pliki.zapiszMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+
+		konta[0]->uznaj(Pieniadze::zZlotych(50));
+		Transakcja wplata;
+		wplata.setTypTransakcji(TypTransakcji::WPLATA);
+		wplata.setKwota(Pieniadze::zZlotych(50));
+		wplata.setMiesiacTransakcji(Kalendarz::globalny().getMiesiac());
+		wplata.setIdOdbiorcy(konta[0]->getIdKonta());
+		transakcje.push_back(wplata);
+		json zmiany = json::array();
+		pliki.dodajOperacje(zmiany, *konta[0]);
+		pliki.dodajOperacje(zmiany, wplata, 0);
+		SPRAWDZ(pliki.zapiszDoDziennika(zmiany));
+		zwolnij(konta, karty);
+		transakcje.clear();
+	}
+	{
+		// Awaria przed punktem kontrolnym: wplata jest tylko w dzienniku
+		FileManager pliki("testy.json");
+		SPRAWDZ(pliki.wczytajMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+		SPRAWDZ(konta.size() == 1 && konta[0]->getSaldoKonta() == Pieniadze::zZlotych(100));
+		pliki.odtworzDziennik(klienci, transakcje, karty, lokaty, konta);
+		SPRAWDZ(pliki.getLiczbaWpisowDziennika() == 1);
+		SPRAWDZ(konta.size() == 1 && konta[0]->getSaldoKonta() == Pieniadze::zZlotych(150));
+		SPRAWDZ(transakcje.size() == 1);
+		pliki.odtworzDziennik(klienci, transakcje, karty, lokaty, konta); // Ponowne odtworzenie niczego nie zmienia
+		SPRAWDZ(konta.size() == 1 && konta[0]->getSaldoKonta() == Pieniadze::zZlotych(150));
+		SPRAWDZ(transakcje.size() == 1);
+
+		// Operacja wsadowa bez wpisu w dzienniku, a potem awaria miedzy podmiana migawki
+		// a wyczyszczeniem dziennika
+		konta[0]->uznaj(Pieniadze::zZlotych(10));
+		SPRAWDZ(pliki.zapiszMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+		zwolnij(konta, karty);
+		transakcje.clear();
+	}
+	{
+		FileManager pliki("testy.json");
+		SPRAWDZ(pliki.wczytajMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+		pliki.odtworzDziennik(klienci, transakcje, karty, lokaty, konta);
+		SPRAWDZ(pliki.getLiczbaWpisowDziennika() == 0);
+		SPRAWDZ(konta.size() == 1 && konta[0]->getSaldoKonta() == Pieniadze::zZlotych(160)); // Nie cofniete do 150
+		SPRAWDZ(transakcje.size() == 1);
+		zwolnij(konta, karty);
+	}
+	// Nieaktualne wpisy zostaly usuniete z dziennika
+	ifstream dziennik("dziennik_testy.json");
+	SPRAWDZ(dziennik.is_open() && dziennik.peek() == ifstream::traits_type::eof());
+	dziennik.close();
+	usunPlikiTestowe();
+}
+
+/**
+ * @brief Migawka binarna odtwarza wszystkie zapisane pola, a uszkodzona migawka nie jest
+ * traktowana jak jej brak.
+ */
+void testMigawki()
+{
+	usunPlikiTestowe();
+	deque<Klient> klienci;
+	vector<Transakcja> transakcje;
+	vector<Karta*> karty;
+	vector<Lokata> lokaty;
+	vector<KontoGlowne*> konta;
+	const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+	const uint32_t dzien = Kalendarz::globalny().getDzien();
+	{
+		FileManager pliki("testy.json");
+		SPRAWDZ(!pliki.wczytajMigawkeBinarna(klienci, transakcje, karty, lokaty, konta)); // Brak migawki
+
+		klienci.emplace_back("Jan", "Kowalski", "90010112345", "jan", "tajne");
+		KontoGlowne* glowne = new KontoGlowne("T101", "Glowne", Pieniadze::zGroszy(123456));
+		glowne->setWlascicielel("90010112345");
+		KontoOszczednosciowe* oszczednosciowe = new KontoOszczednosciowe("T102", Pieniadze::zGroszy(-1), 3.5f, "01/2024", 4);
+		oszczednosciowe->setWlascicielel("90010112345");
+		oszczednosciowe->setWykonaneWyplaty(2, miesiac);
+		konta.push_back(glowne);
+		konta.push_back(oszczednosciowe);
+
+		KartaDebetowa* karta = new KartaDebetowa("4000123412341234", "12/2099", "321", "T101", Pieniadze::zGroszy(50000));
+		karta->setPin("9876");
+		karta->setWydaneDzisiaj(Pieniadze::zGroszy(1999), dzien);
+		karty.push_back(karta);
+
+		lokaty.emplace_back(Pieniadze::zGroszy(10000), 4.25f, "06/2030", "T102");
+		lokaty.emplace_back(Pieniadze::zGroszy(500), 1.0f, "01/2020", "T101");
+		lokaty.back().setRozliczona(true);
+
+		Transakcja przelew;
+		przelew.setTypTransakcji(TypTransakcji::PRZELEW);
+		przelew.setKwota(Pieniadze::zGroszy(777));
+		przelew.setMiesiacTransakcji(miesiac);
+		przelew.setZnacznikCzasu(1700000000);
+		przelew.setIdNadawcy(glowne->getIdKonta());
+		przelew.setIdOdbiorcy(oszczednosciowe->getIdKonta());
+		transakcje.push_back(przelew);
+
+		SPRAWDZ(pliki.zapiszMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+		zwolnij(konta, karty);
+		klienci.clear();
+		lokaty.clear();
+		transakcje.clear();
+	}
+	{
+		FileManager pliki("testy.json");
+		SPRAWDZ(pliki.wczytajMigawkeBinarna(klienci, transakcje, karty, lokaty, konta));
+
+		SPRAWDZ(klienci.size() == 1);
+		SPRAWDZ(klienci[0].getImie() == "Jan" && klienci[0].getNazwisko() == "Kowalski");
+		SPRAWDZ(klienci[0].getPesel() == "90010112345" && klienci[0].getLogin() == "jan" && klienci[0].getHaslo() == "tajne");
+
+		SPRAWDZ(konta.size() == 2);
+		if (konta.size() == 2)
+		{
+			SPRAWDZ(konta[0]->getNumerKonta() == "T101" && konta[0]->getTypKonta() == "Glowne");
+			SPRAWDZ(konta[0]->getSaldoKonta() == Pieniadze::zGroszy(123456));
+			SPRAWDZ(konta[0]->getWlasciciel() == "90010112345");
+			KontoOszczednosciowe* oszczednosciowe = dynamic_cast<KontoOszczednosciowe*>(konta[1]);
+			SPRAWDZ(oszczednosciowe != nullptr);
+			if (oszczednosciowe != nullptr)
+			{
+				SPRAWDZ(oszczednosciowe->getNumerKonta() == "T102");
+				SPRAWDZ(oszczednosciowe->getSaldoKonta() == Pieniadze::zGroszy(-1));
+				SPRAWDZ(oszczednosciowe->getOprocentowanie() == 3.5f);
+				SPRAWDZ(oszczednosciowe->getMiesiacKapitalizacji() == 202401);
+				SPRAWDZ(oszczednosciowe->getOgraniczenieWyplat() == 4);
+				SPRAWDZ(oszczednosciowe->getLicznikWyplat() == 2 && oszczednosciowe->getMiesiacWyplat() == miesiac);
+			}
+		}
+
+		SPRAWDZ(karty.size() == 1);
+		KartaDebetowa* karta = karty.empty() ? nullptr : dynamic_cast<KartaDebetowa*>(karty[0]);
+		SPRAWDZ(karta != nullptr);
+		if (karta != nullptr)
+		{
+			SPRAWDZ(karta->getNumerKarty() == "4000123412341234" && karta->getMiesiacWaznosci() == 209912);
+			SPRAWDZ(karta->getKodCVC() == "321" && karta->czyPoprawnyPin("9876"));
+			SPRAWDZ(karta->getPowiazaneKonto() == "T101");
+			SPRAWDZ(karta->getDziennyLimit() == Pieniadze::zGroszy(50000));
+			SPRAWDZ(karta->getLicznikWydatkow() == Pieniadze::zGroszy(1999) && karta->getDzienWydatkow() == dzien);
+		}
+
+		SPRAWDZ(lokaty.size() == 2);
+		if (lokaty.size() == 2)
+		{
+			SPRAWDZ(lokaty[0].getKwota() == Pieniadze::zGroszy(10000) && lokaty[0].getOprocentowanie() == 4.25f);
+			SPRAWDZ(lokaty[0].getMiesiacOddania() == 203006 && lokaty[0].getPowiazaneKonto() == "T102");
+			SPRAWDZ(!lokaty[0].czyRozliczona() && lokaty[1].czyRozliczona());
+		}
+
+		SPRAWDZ(transakcje.size() == 1);
+		if (transakcje.size() == 1)
+		{
+			SPRAWDZ(transakcje[0].getTyp() == TypTransakcji::PRZELEW && transakcje[0].getKwota() == Pieniadze::zGroszy(777));
+			SPRAWDZ(transakcje[0].getMiesiacTransakcji() == miesiac && transakcje[0].getZnacznikCzasu() == 1700000000);
+			SPRAWDZ(transakcje[0].getKontoNadawcy() == "T101" && transakcje[0].getKontoOdbiorcy() == "T102");
+		}
+		zwolnij(konta, karty);
+		klienci.clear();
+		lokaty.clear();
+		transakcje.clear();
+	}
+	{
+		// Ucieta migawka - wczytanie konczy sie bledem zamiast pustego banku lub importu z JSON
+		ifstream wejscie("testy.bin", ios::binary);
+		string zawartosc((istreambuf_iterator<char>(wejscie)), istreambuf_iterator<char>());
+		wejscie.close();
+		ofstream wyjscie("testy.bin", ios::binary | ios::trunc);
+		wyjscie.write(zawartosc.data(), zawartosc.size() / 2);
+		wyjscie.close();
+
+		FileManager pliki("testy.json");
+		bool blad = false;
+		try {
+			pliki.wczytajMigawkeBinarna(klienci, transakcje, karty, lokaty, konta);
+		}
+		catch (const Error&)
+		{
+			blad = true;
+		}
+		SPRAWDZ(blad);
+		zwolnij(konta, karty);
+	}
+	usunPlikiTestowe();
+}
+
+/**
+ * @brief Uruchamia funkcja(numerWatku) na kilku watkach jednoczesnie i czeka na ich koniec.
+ */
+template <typename Funkcja>
+void naWatkach(size_t liczbaWatkow, Funkcja funkcja)
+{
+	atomic<bool> start(false);
+	vector<thread> watki;
+	for (size_t w = 0; w < liczbaWatkow; w++)
+	{
+		watki.emplace_back([&, w]
+		{
+			while (!start.load()) this_thread::yield();
+			funkcja(w);
+		});
+	}
+	start.store(true);
+	for (auto& watek : watki) watek.join();
+}
+
+/**
+ * @brief Rownolegle obciazenia konta oszczednosciowego nie przekraczaja miesiecznego limitu
+ * wyplat, a odrzucone z braku srodkow nie zuzywaja limitu.
+ */
+void testLimituWyplat()
+{
+	const size_t liczbaWatkow = 8;
+	const uint32_t miesiac = Kalendarz::globalny().getMiesiac();
+
+	KontoOszczednosciowe konto("T201", Pieniadze::zZlotych(1000000), 2.0f, "01/2024", 5);
+	atomic<int> udane(0);
+	naWatkach(liczbaWatkow, [&](size_t)
+	{
+		for (int i = 0; i < 200; i++) udane += konto.obciaz(Pieniadze::zZlotych(1));
+	});
+	SPRAWDZ(udane.load() == 5);
+	SPRAWDZ(konto.getLicznikWyplat() == 5 && konto.getMiesiacWyplat() == miesiac);
+	SPRAWDZ(konto.getSaldoKonta() == Pieniadze::zZlotych(1000000 - 5));
+
+	// Srodki wystarczaja na 3 z 10 mozliwych wyplat
+	KontoOszczednosciowe biedne("T202", Pieniadze::zZlotych(30), 2.0f, "01/2024", 10);
+	udane = 0;
+	naWatkach(liczbaWatkow, [&](size_t)
+	{
+		for (int i = 0; i < 50; i++) udane += biedne.obciaz(Pieniadze::zZlotych(10));
+	});
+	SPRAWDZ(udane.load() == 3);
+	SPRAWDZ(biedne.getLicznikWyplat() == 3);
+	SPRAWDZ(biedne.getSaldoKonta() == Pieniadze());
+
+	// Licznik z poprzedniego miesiaca nie blokuje wyplat w biezacym
+	biedne.setWykonaneWyplaty(10, miesiac - 1);
+	biedne.uznaj(Pieniadze::zZlotych(10));
+	SPRAWDZ(biedne.getWykonaneWyplatywWMiesiacu() == 0);
+	SPRAWDZ(biedne.obciaz(Pieniadze::zZlotych(10)));
+	SPRAWDZ(biedne.getLicznikWyplat() == 1 && biedne.getMiesiacWyplat() == miesiac);
+}
+
+/**
+ * @brief Przelewy w przeciwnych kierunkach miedzy tymi samymi kontami nie zakleszczaja sie
+ * (blokady sa brane w stalej kolejnosci), a suma sald banku sie nie zmienia.
+ */
+void testPrzelewowWspolbieznych()
+{
+	const size_t liczbaKont = 4;
+	vector<unique_ptr<KontoGlowne>> konta;
+	for (size_t i = 0; i < liczbaKont; i++)
+	{
+		konta.emplace_back(new KontoGlowne("T30" + to_string(i), "Glowne", Pieniadze::zZlotych(100)));
+	}
+	vector<KontoGlowne*> kontaPoId(SlownikNumerow::globalny().size(), nullptr);
+	for (auto& konto : konta) kontaPoId[konto->getIdKonta()] = konto.get();
+	SilnikPrzelewow silnik(kontaPoId);
+
+	const uint32_t a = konta[0]->getIdKonta();
+	const uint32_t b = konta[1]->getIdKonta();
+	SPRAWDZ(silnik.przelej({ a, a, Pieniadze::zZlotych(1) }) == WynikPrzelewu::TO_SAMO_KONTO);
+	SPRAWDZ(silnik.przelej({ a, b, Pieniadze() }) == WynikPrzelewu::NIEPOPRAWNA_KWOTA);
+	SPRAWDZ(silnik.przelej({ a, static_cast<uint32_t>(kontaPoId.size()), Pieniadze::zZlotych(1) }) == WynikPrzelewu::BRAK_KONTA);
+	SPRAWDZ(silnik.przelej({ a, b, Pieniadze::zZlotych(101) }) == WynikPrzelewu::ODRZUCONY);
+
+	// Kazdy watek przelewa w innym kierunku, wiec pary blokad sa brane w obu kolejnosciach kont
+	atomic<size_t> wykonane(0);
+	naWatkach(8, [&](size_t w)
+	{
+		uint64_t los = 88172645463325252ull + w;
+		for (int i = 0; i < 20000; i++)
+		{
+			los ^= los << 13; los ^= los >> 7; los ^= los << 17;
+			ZleceniePrzelewu zlecenie;
+			zlecenie.nadawca = konta[(w + i) % liczbaKont]->getIdKonta();
+			zlecenie.odbiorca = konta[(w + i + 1 + (w & 1) * 2) % liczbaKont]->getIdKonta();
+			zlecenie.kwota = Pieniadze::zGroszy(static_cast<int64_t>(los % 5000) + 1);
+			wykonane += silnik.przelej(zlecenie) == WynikPrzelewu::WYKONANY;
+		}
+	});
+	SPRAWDZ(wykonane.load() > 0);
+	Pieniadze suma;
+	for (auto& konto : konta)
+	{
+		suma += konto->getSaldoKonta();
+		SPRAWDZ(!konto->getSaldoKonta().czyUjemna());
+	}
+	SPRAWDZ(suma == Pieniadze::zZlotych(100 * liczbaKont));
+}
+
+/**
+ * @brief Rownolegle autoryzacje jedna karta nie przekraczaja dziennego limitu, a platnosci
+ * odrzucone z braku srodkow nie zuzywaja limitu.
+ */
+void testLimituKarty()
+{
+	KontoGlowne bogate("T401", "Glowne", Pieniadze::zZlotych(10000));
+	KontoGlowne biedne("T402", "Glowne", Pieniadze::zZlotych(25));
+	vector<KontoGlowne*> kontaPoId(SlownikNumerow::globalny().size(), nullptr);
+	kontaPoId[bogate.getIdKonta()] = &bogate;
+	kontaPoId[biedne.getIdKonta()] = &biedne;
+
+	KartaDebetowa kartaBogatego("4000000000000401", "12/2099", "123", "T401", Pieniadze::zZlotych(100));
+	KartaDebetowa kartaBiednego("4000000000000402", "12/2099", "123", "T402", Pieniadze::zZlotych(100));
+	kartaBogatego.setPin("1111");
+	kartaBiednego.setPin("2222");
+	AutoryzacjaKart autoryzacja(kontaPoId);
+	SPRAWDZ(autoryzacja.dodaj(&kartaBogatego) && autoryzacja.dodaj(&kartaBiednego));
+	SPRAWDZ(!autoryzacja.dodaj(&kartaBogatego)); // Powtorzony numer
+
+	SPRAWDZ(autoryzacja.autoryzuj("4000000000000401", "0000", Pieniadze::zZlotych(1)) == WynikAutoryzacji::NIEPOPRAWNY_PIN);
+	SPRAWDZ(autoryzacja.autoryzuj("4000000000000499", "1111", Pieniadze::zZlotych(1)) == WynikAutoryzacji::NIEZNANA_KARTA);
+
+	atomic<int> zaakceptowane(0);
+	atomic<int> ponadLimit(0);
+	naWatkach(8, [&](size_t)
+	{
+		for (int i = 0; i < 50; i++)
+		{
+			WynikAutoryzacji wynik = autoryzacja.autoryzuj("4000000000000401", "1111", Pieniadze::zZlotych(10));
+			zaakceptowane += wynik == WynikAutoryzacji::ZAAKCEPTOWANA;
+			ponadLimit += wynik == WynikAutoryzacji::PRZEKROCZONY_LIMIT;
+		}
+	});
+	SPRAWDZ(zaakceptowane.load() == 10 && ponadLimit.load() == 8 * 50 - 10);
+	SPRAWDZ(kartaBogatego.getWydaneDzisiaj() == Pieniadze::zZlotych(100));
+	SPRAWDZ(bogate.getSaldoKonta() == Pieniadze::zZlotych(10000 - 100));
+
+	// Srodki wystarczaja na 2 z 10 platnosci mieszczacych sie w limicie
+	zaakceptowane = 0;
+	naWatkach(8, [&](size_t)
+	{
+		for (int i = 0; i < 50; i++)
+		{
+			zaakceptowane += autoryzacja.autoryzuj("4000000000000402", "2222", Pieniadze::zZlotych(10)) == WynikAutoryzacji::ZAAKCEPTOWANA;
+		}
+	});
+	SPRAWDZ(zaakceptowane.load() == 2);
+	SPRAWDZ(kartaBiednego.getWydaneDzisiaj() == Pieniadze::zZlotych(20));
+	SPRAWDZ(biedne.getSaldoKonta() == Pieniadze::zZlotych(5));
+
+	// Licznik z poprzedniego dnia nie zmniejsza dzisiejszego limitu
+	kartaBiednego.setWydaneDzisiaj(Pieniadze::zZlotych(100), Kalendarz::globalny().getDzien() - 1);
+	SPRAWDZ(autoryzacja.autoryzuj("4000000000000402", "2222", Pieniadze::zZlotych(5)) == WynikAutoryzacji::ZAAKCEPTOWANA);
+	SPRAWDZ(kartaBiednego.getWydaneDzisiaj() == Pieniadze::zZlotych(5));
+}
+
+int main()
+{
+	Kalendarz::globalny().odswiez();
+	testPieniedzy();
+	testOdtwarzaniaDziennika();
+	testMigawki();
+	testLimituWyplat();
+	testPrzelewowWspolbieznych();
+	testLimituKarty();
+
+	cout << "Testy: " << liczbaSprawdzen << " sprawdzen, " << liczbaBledow << " bledow." << endl;
+	return liczbaBledow == 0 ? 0 : 1;
+}